@@ -165,6 +165,7 @@ Size BootImageCreate::readBootSymbols(const char *conf_file,
             entry->regions[0].access = Memory::User | Memory::Readable | Memory::Writable;
             entry->regions[0].size = st.st_size;
             entry->regions[0].data = buffer;
+            entry->regions[0].dataSize = st.st_size;
         } else {
             fprintf(stderr, "%s: unknown boot symbol type: %d\n",
                     prog, (uint) entry->symbol.type);
@@ -307,13 +308,25 @@ BootImageCreate::Result BootImageCreate::exec()
             }
 
             // Write segment contents
-            if (fwrite(input[i]->regions[j].data,
-                       input[i]->regions[j].size, 1, fp) <= 0)
+            if (input[i]->regions[j].dataSize &&
+                fwrite(input[i]->regions[j].data,
+                       input[i]->regions[j].dataSize, 1, fp) <= 0)
             {
                 fprintf(stderr, "%s: failed to write BootSegment contents to `%s': %s\n",
                         prog, out_file, strerror(errno));
                 return IOError;
             }
+
+            // Zero-fill the remainder of the segment
+            for (Size k = input[i]->regions[j].dataSize; k < input[i]->regions[j].size; k++)
+            {
+                if (fputc(0, fp) == EOF)
+                {
+                    fprintf(stderr, "%s: failed to write BootSegment contents to `%s': %s\n",
+                            prog, out_file, strerror(errno));
+                    return IOError;
+                }
+            }
         }
     }
     // Close file
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <Log.h>
+#include "RunCommand.h"
+
+RunCommand::RunCommand() : ShellCommand("run", 1)
+{
+    m_help = "Run a program on the processor core with the least load";
+}
+
+int RunCommand::execute(Size nparams, char **params)
+{
+    char tmp[128];
+
+    // Try to execute it as a file directly
+    if (spawnany(params[0], (const char **) params) == 0)
+        return 0;
+
+    // Try to find it on the filesystem. (temporary hardcoded PATH)
+    snprintf(tmp, sizeof(tmp), "/bin/%s", params[0]);
+    if (spawnany(tmp, (const char **) params) == 0)
+        return 0;
+
+    ERROR("spawnany `" << params[0] << "' failed: " << strerror(errno));
+    return EXIT_FAILURE;
+}
@@ -23,6 +23,7 @@
 #include "WriteCommand.h"
 #include "HelpCommand.h"
 #include "TimeCommand.h"
+#include "RunCommand.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -50,6 +51,7 @@ Shell::Shell(int argc, char **argv)
     registerCommand(new WriteCommand());
     registerCommand(new HelpCommand(this));
     registerCommand(new TimeCommand());
+    registerCommand(new RunCommand());
 }
 
 Shell::~Shell()
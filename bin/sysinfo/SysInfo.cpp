@@ -66,6 +66,13 @@ SysInfo::Result SysInfo::exec()
             timer.frequency,
             (u32) tv.tv_sec, tv.tv_usec);
 
+    printf("Context Switches: %u\r\n"
+           "Channel Full:     %u\r\n"
+           "Copy Pages:       %u\r\n",
+            (u32) info.stats.contextSwitches,
+            (u32) info.stats.channelFull,
+            (u32) info.stats.copyPages);
+
     // Done
     return Success;
 }
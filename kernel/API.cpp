@@ -60,6 +60,7 @@ Log & operator << (Log &log, API::Operation op)
         case API::Read:        log.append("Read");        break;
         case API::ReadPhys:    log.append("ReadPhys");    break;
         case API::Write:       log.append("Write");       break;
+        case API::Zero:        log.append("Zero");        break;
     }
     return log;
 }
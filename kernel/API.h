@@ -93,7 +93,8 @@ class API
         SendReceive = 4,
         Read        = 5,
         Write       = 6,
-        ReadPhys    = 7
+        ReadPhys    = 7,
+        Zero        = 8
     }
     Operation;
 
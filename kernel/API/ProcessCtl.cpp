@@ -72,12 +72,25 @@ API::Result ProcessCtlHandler(ProcessID procID,
         break;
 
     case Resume:
+        // mark the channel from the caller as pending
+        proc->ringDoorbell(procs->current()->getID());
+
         // increment wakeup counter and set process ready
         if (procs->wakeup(proc) != ProcessManager::Success)
         {
             ERROR("failed to wakeup process ID " << proc->getID());
             return API::IOError;
         }
+        // Run the process immediately if it has a higher priority
+        procs->preempt();
+        break;
+
+    case SetPriority:
+        if (procs->setPriority(proc, (Process::Priority) addr) != ProcessManager::Success)
+        {
+            ERROR("failed to set priority " << addr << " on process ID " << proc->getID());
+            return API::InvalidArgument;
+        }
         break;
 
     case WatchIRQ:
@@ -100,6 +113,7 @@ API::Result ProcessCtlHandler(ProcessID procID,
         info->id    = proc->getID();
         info->state = proc->getState();
         info->parent = proc->getParent();
+        info->priority = proc->getPriority();
         break;
 
     case WaitPID:
@@ -160,6 +174,7 @@ Log & operator << (Log &log, ProcessOperation op)
         case EnterSleep: log.append("EnterSleep"); break;
         case Schedule:  log.append("Schedule"); break;
         case Resume:    log.append("Resume"); break;
+        case SetPriority: log.append("SetPriority"); break;
         default:        log.append("???"); break;
     }
     return log;
@@ -51,6 +51,7 @@ typedef enum ProcessOperation
     EnterSleep,
     Schedule,
     Resume,
+    SetPriority
 }
 ProcessOperation;
 
@@ -67,6 +68,9 @@ typedef struct ProcessInfo
 
     /** Defines the current state of the Process. */
     Process::State state;
+
+    /** Scheduling priority of the Process. */
+    Process::Priority priority;
 }
 ProcessInfo;
 
@@ -79,7 +83,7 @@ Log & operator << (Log &log, ProcessOperation op);
  * @param proc Target Process' ID.
  * @param op The operation to perform.
  * @param addr Input argument address, used for program entry point for Spawn,
- *             ProcessInfo pointer for Info.
+ *             ProcessInfo pointer for Info and Process::Priority for SetPriority.
  * @param output Output argument address (optional).
  *
  * @return API::Success on success and other API::ErrorCode on failure.
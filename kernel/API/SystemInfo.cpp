@@ -39,6 +39,8 @@ API::Result SystemInfoHandler(SystemInformation *info)
     info->timerCounter     = core->timerCounter;
     info->coreChannelAddress = core->coreChannelAddress;
     info->coreChannelSize    = core->coreChannelSize;
+    info->runnable           = Kernel::instance->getProcessManager()->getReadyCount();
+    info->stats              = *Kernel::instance->getStatistics();
 
     MemoryBlock::copy(info->cmdline, coreInfo.kernelCommand, 64);
     return API::Success;
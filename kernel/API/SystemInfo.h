@@ -107,6 +107,12 @@ typedef struct SystemInformation
 
     /** Timer counter */
     uint timerCounter;
+
+    /** Number of processes ready to run on this core */
+    Size runnable;
+
+    /** Kernel statistics counters of this core */
+    KernelStatistics stats;
 }
 SystemInformation;
 
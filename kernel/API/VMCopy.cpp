@@ -23,11 +23,15 @@ API::Result VMCopyHandler(ProcessID procID, API::Operation how, Address ours,
                           Address theirs, Size sz)
 {
     ProcessManager *procs = Kernel::instance->getProcessManager();
+    SplitAllocator *alloc = Kernel::instance->getAllocator();
     Process *proc;
-    Address paddr, vaddr;
+    Address paddr, vaddr, slot = ZERO;
     Size bytes = 0, pageOff, total = 0;
+    API::Result ret = API::Success;
+    bool mapped = false;
 
     DEBUG("");
+    STATISTICS_START(start);
 
     // Find the corresponding Process
     if (procID == SELF)
@@ -45,7 +49,10 @@ API::Result VMCopyHandler(ProcessID procID, API::Operation how, Address ours,
         if (how == API::ReadPhys)
             paddr = theirs & PAGEMASK;
         else if (remote->lookup(theirs, &paddr) != MemoryContext::Success)
-            return API::AccessViolation;
+        {
+            ret = API::AccessViolation;
+            break;
+        }
 
         paddr &= PAGEMASK;
         pageOff = theirs & ~PAGEMASK;
@@ -55,11 +62,25 @@ API::Result VMCopyHandler(ProcessID procID, API::Operation how, Address ours,
         // Valid address?
         if (!paddr) break;
 
-        // Map their address into our local address space
-        if (local->findFree(PAGESIZE, MemoryMap::KernelPrivate, &vaddr) != MemoryContext::Success)
-            return API::RangeError;
+        // Low memory is always mapped in the kernel
+        if (alloc->isLow(paddr))
+            vaddr = (Address) alloc->toVirtual(paddr);
+        else
+        {
+            // Reserve a single copy slot for all other pages
+            if (!slot && local->findFree(PAGESIZE, MemoryMap::KernelPrivate, &slot) != MemoryContext::Success)
+            {
+                ret = API::RangeError;
+                break;
+            }
+            // Map their address into our local address space
+            if (mapped)
+                local->unmap(slot);
 
-        local->map(vaddr, paddr, Memory::Readable | Memory::Writable);
+            vaddr  = slot;
+            mapped = local->map(vaddr, paddr, Memory::Readable | Memory::Writable) == MemoryContext::Success;
+            STATISTICS_ADD(copyPages, 1);
+        }
 
         // Process the action appropriately
         switch (how)
@@ -73,17 +94,27 @@ API::Result VMCopyHandler(ProcessID procID, API::Operation how, Address ours,
                 MemoryBlock::copy((void *)(vaddr + pageOff), (void *)ours, bytes);
                 break;
 
+            case API::Zero:
+                MemoryBlock::set((void *)(vaddr + pageOff), 0, bytes);
+                break;
+
             default:
                 ;
         }
 
-        // Unmap
-        local->unmap(vaddr);
-
         // Update counters
         ours   += bytes;
         theirs += bytes;
         total  += bytes;
     }
+    // Release the copy slot
+    if (mapped)
+        local->unmap(slot);
+
+    STATISTICS_STOP(copyCycles, start);
+
+    if (ret != API::Success)
+        return ret;
+
     return total;
 }
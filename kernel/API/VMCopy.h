@@ -32,7 +32,7 @@
  * Prototype for user applications. Copies virtual memory between two processes.
  *
  * @param proc Remote process.
- * @param how Read or Write.
+ * @param how Read, Write, ReadPhys or Zero to fill the remote buffer with zero bytes.
  * @param ours Virtual address of the buffer of this process.
  * @param theirs Virtual address of the remote process' buffer.
  * @param sz Amount of memory to copy.
@@ -19,7 +19,7 @@
 #include <Log.h>
 #include <ListIterator.h>
 #include <SplitAllocator.h>
-#include <BubbleAllocator.h>
+#include <BitAllocator.h>
 #include <PoolAllocator.h>
 #include <IntController.h>
 #include <BootImage.h>
@@ -52,6 +52,7 @@ Kernel::Kernel(CoreInfo *info)
     m_coreInfo   = info;
     m_intControl = ZERO;
     m_timer      = ZERO;
+    MemoryBlock::set(&m_stats, 0, sizeof(m_stats));
 
     // Mark kernel memory used (first 4MB in phys memory)
     for (Size i = 0; i < info->kernel.size; i += PAGESIZE)
@@ -69,22 +70,38 @@ Kernel::Kernel(CoreInfo *info)
     for (Size i = 0; i < m_coreInfo->coreChannelSize; i += PAGESIZE)
         m_alloc->allocate(m_coreInfo->coreChannelAddress + i);
 
+    // Publish our load to the CoreServer, if the CoreChannel has room for it
+    if (m_coreInfo->coreChannelSize > COREINFO_LOAD_OFFSET)
+    {
+        m_procs->setCoreLoad((CoreLoad *) m_alloc->toVirtual(
+            m_coreInfo->coreChannelAddress + COREINFO_LOAD_OFFSET));
+    }
+
     // Clear interrupts table
     m_interrupts.fill(ZERO);
 }
 
 Error Kernel::heap(Address base, Size size)
 {
-    Allocator *bubble, *pool;
-    Size meta = sizeof(BubbleAllocator) + sizeof(PoolAllocator);
+    Allocator *slabs, *pool;
+    Memory::Range range;
+    Size meta = sizeof(BitAllocator) + sizeof(PoolAllocator);
+    Size bitmap = (((size / POOL_SLAB_SIZE) + 63) / 64) * 8;
 
     // Clear the heap first
     MemoryBlock::set((void *) base, 0, size);
 
-    // Setup the dynamic memory heap
-    bubble = new (base) BubbleAllocator(base + meta, size - meta);
-    pool   = new (base + sizeof(BubbleAllocator)) PoolAllocator();
-    pool->setParent(bubble);
+    // Slabs start after the allocators and their bitmap
+    range.virt   = ZERO;
+    range.phys   = (base + meta + bitmap + POOL_SLAB_SIZE - 1) & ~((Address) POOL_SLAB_SIZE - 1);
+    range.size   = (base + size - range.phys) & ~((Address) POOL_SLAB_SIZE - 1);
+    range.access = Memory::None;
+
+    // Setup the dynamic memory heap. Pools which become
+    // empty are given back to the slabs for reuse.
+    slabs = new (base) BitAllocator(range, POOL_SLAB_SIZE, (u8 *) (base + meta));
+    pool  = new (base + sizeof(BitAllocator)) PoolAllocator();
+    pool->setParent(slabs);
 
     // Set default allocator
     Allocator::setDefault(pool);
@@ -121,6 +138,11 @@ Timer * Kernel::getTimer()
     return m_timer;
 }
 
+KernelStatistics * Kernel::getStatistics()
+{
+    return &m_stats;
+}
+
 void Kernel::enableIRQ(u32 irq, bool enabled)
 {
     if (m_intControl)
@@ -26,6 +26,7 @@
 #include <CoreInfo.h>
 #include "Process.h"
 #include "ProcessManager.h"
+#include "Statistics.h"
 
 /** Forward declarations. */
 class API;
@@ -160,6 +161,13 @@ class Kernel : public Singleton<Kernel>
      */
     Timer * getTimer();
 
+    /**
+     * Get statistics counters.
+     *
+     * @return KernelStatistics object pointer
+     */
+    KernelStatistics * getStatistics();
+
     /**
      * Execute the kernel.
      */
@@ -228,6 +236,9 @@ class Kernel : public Singleton<Kernel>
 
     /** Timer device. */
     Timer *m_timer;
+
+    /** Statistics counters for this core. */
+    KernelStatistics m_stats;
 };
 
 /**
@@ -20,6 +20,7 @@
 #include <Index.h>
 #include <MemoryBlock.h>
 #include <MemoryChannel.h>
+#include <Doorbell.h>
 #include <SplitAllocator.h>
 #include "Process.h"
 #include "ProcessEvent.h"
@@ -28,6 +29,10 @@ Process::Process(ProcessID id, Address entry, bool privileged, const MemoryMap &
     : m_id(id), m_map(map), m_shares(id)
 {
     m_state         = Sleeping;
+    m_priority      = Normal;
+    m_level         = Normal;
+    m_scheduleNext  = ZERO;
+    m_schedulePrev  = ZERO;
     m_parent        = 0;
     m_waitId        = 0;
     m_waitResult    = 0;
@@ -36,12 +41,15 @@ Process::Process(ProcessID id, Address entry, bool privileged, const MemoryMap &
     m_privileged    = privileged;
     m_memoryContext = ZERO;
     m_kernelChannel = new MemoryChannel;
+    m_doorbell      = new Doorbell;
+    m_sleepIndex    = 0;
     MemoryBlock::set(&m_sleepTimer, 0, sizeof(m_sleepTimer));
 }
 
 Process::~Process()
 {
     delete m_kernelChannel;
+    delete m_doorbell;
 
     if (m_memoryContext)
     {
@@ -85,6 +93,11 @@ Process::State Process::getState() const
     return m_state;
 }
 
+Process::Priority Process::getPriority() const
+{
+    return m_priority;
+}
+
 ProcessShares & Process::getShares()
 {
     return m_shares;
@@ -128,13 +141,23 @@ Process::Result Process::raiseEvent(ProcessEvent *event)
 {
     // Write the message. Be sure to flush the caches because
     // the kernel has mapped the channel pages separately in low memory.
-    m_kernelChannel->write(event);
+    if (m_kernelChannel->write(event) == MemoryChannel::ChannelFull)
+        STATISTICS_ADD(channelFull, 1);
+
     m_kernelChannel->flush();
 
     // Wakeup the Process, if needed
     return wakeup();
 }
 
+Process::Result Process::ringDoorbell(ProcessID pid)
+{
+    if (m_doorbell->ring(pid) != Doorbell::Success)
+        return InvalidArgument;
+
+    return Success;
+}
+
 Process::Result Process::initialize()
 {
     Memory::Range range;
@@ -142,9 +165,9 @@ Process::Result Process::initialize()
     Arch::Cache cache;
     Allocator::Arguments alloc_args;
 
-    // Allocate two pages for the kernel event channel
+    // Allocate pages for the kernel event channel and doorbell
     alloc_args.address = 0;
-    alloc_args.size = PAGESIZE * 2;
+    alloc_args.size = PAGESIZE * 4;
     alloc_args.alignment = PAGESIZE;
 
     if (Kernel::instance->getAllocator()->allocateLow(alloc_args) != Allocator::Success)
@@ -156,21 +179,24 @@ Process::Result Process::initialize()
 
     // Translate to virtual address in kernel low memory
     vaddr = (Address) Kernel::instance->getAllocator()->toVirtual(paddr);
-    MemoryBlock::set((void *)vaddr, 0, PAGESIZE*2);
-    cache.cleanData(vaddr);
-    cache.cleanData(vaddr + PAGESIZE);
+    MemoryBlock::set((void *)vaddr, 0, PAGESIZE*4);
+    for (Size i = 0; i < PAGESIZE*4; i += PAGESIZE)
+        cache.cleanData(vaddr + i);
 
-    // Map data and feedback pages in userspace
+    // Map data, feedback and doorbell pages in userspace
     range.phys   = paddr;
     range.access = Memory::User | Memory::Readable;
-    range.size   = PAGESIZE * 2;
+    range.size   = PAGESIZE * 4;
     m_memoryContext->findFree(range.size, MemoryMap::UserPrivate, &range.virt);
     m_memoryContext->mapRange(&range);
 
-    // Remap the feedback page with write permissions
-    m_memoryContext->unmap(range.virt + PAGESIZE);
-    m_memoryContext->map(range.virt + PAGESIZE,
-                         range.phys + PAGESIZE, Memory::User | Memory::Readable | Memory::Writable);
+    // Remap the feedback and acknowledge pages with write permissions
+    for (Size i = PAGESIZE; i < PAGESIZE*4; i += PAGESIZE*2)
+    {
+        m_memoryContext->unmap(range.virt + i);
+        m_memoryContext->map(range.virt + i,
+                             range.phys + i, Memory::User | Memory::Readable | Memory::Writable);
+    }
 
     // Create shares entry
     m_shares.setMemoryContext(m_memoryContext);
@@ -181,6 +207,9 @@ Process::Result Process::initialize()
     m_kernelChannel->setMessageSize(sizeof(ProcessEvent));
     m_kernelChannel->setVirtual(vaddr, vaddr + PAGESIZE);
 
+    // Setup the doorbell
+    m_doorbell->setVirtual(vaddr + (PAGESIZE * 2), vaddr + (PAGESIZE * 3));
+
     return Success;
 }
 
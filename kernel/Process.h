@@ -30,9 +30,11 @@
 struct Message;
 class MemoryContext;
 class MemoryChannel;
+class Doorbell;
 struct ProcessEvent;
 class ProcessManager;
 class Scheduler;
+class SleepQueue;
 
 /**
  * @addtogroup kernel
@@ -46,6 +48,7 @@ class Process
 {
   friend class ProcessManager;
   friend class Scheduler;
+  friend class SleepQueue;
 
   public:
 
@@ -71,6 +74,18 @@ class Process
         Waiting
     };
 
+    /**
+     * Scheduling priority of the Process
+     */
+    enum Priority
+    {
+        Lowest = 0,
+        Low,
+        Normal,
+        High,
+        Highest
+    };
+
   public:
 
     /**
@@ -125,6 +140,13 @@ class Process
      */
     State getState() const;
 
+    /**
+     * Retrieve the scheduling priority.
+     *
+     * @return Priority of the Process.
+     */
+    Priority getPriority() const;
+
     /**
      * Get MMU memory context.
      *
@@ -140,6 +162,15 @@ class Process
      */
     bool isPrivileged() const;
 
+    /**
+     * Ring the doorbell of the channel to another process.
+     *
+     * @param pid ProcessID which has written to its channel.
+     *
+     * @return Result code
+     */
+    Result ringDoorbell(ProcessID pid);
+
     /**
      * Compare two processes.
      *
@@ -233,12 +264,27 @@ class Process
     /** Current process status. */
     State m_state;
 
+    /** Scheduling priority */
+    Priority m_priority;
+
+    /** Current run queue level in the Scheduler */
+    Priority m_level;
+
+    /** Next Process on the same Scheduler run queue level */
+    Process *m_scheduleNext;
+
+    /** Previous Process on the same Scheduler run queue level */
+    Process *m_schedulePrev;
+
     /** Waits for exit of this Process. */
     ProcessID m_waitId;
 
     /** Wait exit result of the other Process. */
     uint m_waitResult;
 
+    /** Processes waiting for this Process to terminate. */
+    List<Process *> m_waiters;
+
     /** Privilege level */
     bool m_privileged;
 
@@ -261,11 +307,17 @@ class Process
      */
     Timer::Info m_sleepTimer;
 
+    /** Position in the SleepQueue or ZERO if not in the SleepQueue */
+    Size m_sleepIndex;
+
     /** Contains virtual memory shares between this process and others. */
     ProcessShares m_shares;
 
     /** Channel for sending kernel events to the Process */
     MemoryChannel *m_kernelChannel;
+
+    /** Marks channels of other processes with pending messages */
+    Doorbell *m_doorbell;
 };
 
 /**
@@ -29,8 +29,10 @@ ProcessManager::ProcessManager()
 
     m_current   = ZERO;
     m_idle      = ZERO;
+    m_sliceStart = 0;
+    m_boostStart = 0;
+    m_coreLoad  = ZERO;
     m_interruptNotifyList.fill(ZERO);
-    MemoryBlock::set(&m_nextSleepTimer, 0, sizeof(m_nextSleepTimer));
 }
 
 ProcessManager::~ProcessManager()
@@ -78,26 +80,26 @@ void ProcessManager::remove(Process *proc, uint exitStatus)
         m_current = ZERO;
 
     // Wakeup any Processes which are waiting for this Process
-    Size size = m_procs.size();
-
-    for (Size i = 0; i < size; i++)
+    for (ListIterator<Process *> i(proc->m_waiters); i.hasCurrent(); i++)
     {
-        if (m_procs[i] != ZERO &&
-            m_procs[i]->getState() == Process::Waiting &&
-            m_procs[i]->getWait() == proc->getID())
-        {
-            m_procs[i]->setWaitResult(exitStatus);
-            m_procs[i]->wakeup(true);
-            m_scheduler.enqueue(m_procs[i]);
-        }
+        Process *waiter = i.current();
+
+        waiter->setWaitResult(exitStatus);
+        waiter->wakeup(true);
+        m_scheduler.enqueue(waiter);
     }
 
+    // Stop waiting for another Process
+    if (proc->getState() == Process::Waiting)
+        cancelWait(proc);
+
     // Unregister any interrupt events for this process
     unregisterInterruptNotify(proc);
 
     // Remove process from administration and schedule
     m_procs[proc->getID()] = ZERO;
     m_scheduler.dequeue(proc, true);
+    m_sleepQueue.remove(proc);
 
     // Free the process memory
     delete proc;
@@ -106,6 +108,36 @@ void ProcessManager::remove(Process *proc, uint exitStatus)
 ProcessManager::Result ProcessManager::schedule()
 {
     Timer *timer = Kernel::instance->getTimer();
+    Timer::Info now;
+
+    STATISTICS_START(start);
+    timer->getCurrent(&now);
+
+    // Wakeup all processes which have their sleep timer expired
+    for (Process *p = m_sleepQueue.head();
+         p && timer->isExpired(p->getSleepTimer());
+         p = m_sleepQueue.head())
+    {
+        m_sleepQueue.remove(p);
+        wakeup(p);
+    }
+
+    // Lower the current process one level if it used up a whole time
+    // slice. The first tick of the slice may have been partial.
+    if (m_current && m_current != m_idle &&
+        m_current->getState() == Process::Ready &&
+        now.ticks - m_sliceStart > SCHEDULER_SLICE_TICKS)
+    {
+        m_scheduler.demote(m_current);
+        m_sliceStart = now.ticks;
+    }
+
+    // Periodically restore all processes to their own priority
+    if (now.ticks - m_boostStart >= SCHEDULER_BOOST_TICKS)
+    {
+        m_scheduler.boost();
+        m_boostStart = now.ticks;
+    }
 
     // Let the scheduler select a new process
     Process *proc = m_scheduler.select();
@@ -119,38 +151,22 @@ ProcessManager::Result ProcessManager::schedule()
         FATAL("no process found to run!");
     }
 
-    // Wakeup processes if the next sleeptimer expired
-    if (timer->isExpired(m_nextSleepTimer))
-    {
-        MemoryBlock::set(&m_nextSleepTimer, 0, sizeof(m_nextSleepTimer));
-
-        // Loop all procs, wakeup() those which have their sleep timer expired
-        for (Size i = 0; i < MAX_PROCS; i++)
-        {
-            Process *p = m_procs.at(i);
-            if (p && p->getState() == Process::Sleeping)
-            {
-                const Timer::Info & procTimer = p->getSleepTimer();
-
-                if (timer->isExpired(procTimer))
-                {
-                    wakeup(p);
-                }
-                else if (procTimer.ticks < m_nextSleepTimer.ticks || !m_nextSleepTimer.ticks)
-                {
-                    MemoryBlock::copy(&m_nextSleepTimer, &procTimer, sizeof(m_nextSleepTimer));
-                }
-            }
-        }
-    }
+    // Publish the number of runnable processes for the CoreServer
+    if (m_coreLoad)
+        m_coreLoad->runnable = m_scheduler.count();
 
     // Only execute if its a different process
     if (proc != m_current)
     {
         Process *previous = m_current;
         m_current = proc;
+        m_sliceStart = now.ticks;
+        STATISTICS_ADD(contextSwitches, 1);
+        STATISTICS_STOP(scheduleCycles, start);
         proc->execute(previous);
     }
+    else
+        STATISTICS_STOP(scheduleCycles, start);
 
     return Success;
 }
@@ -166,11 +182,29 @@ void ProcessManager::setIdle(Process *proc)
     m_scheduler.dequeue(proc, true);
 }
 
+void ProcessManager::setCoreLoad(CoreLoad *load)
+{
+    m_coreLoad = load;
+}
+
+Size ProcessManager::getReadyCount() const
+{
+    return m_scheduler.count();
+}
+
 Vector<Process *> * ProcessManager::getProcessTable()
 {
     return &m_procs;
 }
 
+ProcessManager::Result ProcessManager::preempt()
+{
+    if (m_current && m_scheduler.preempts(m_current))
+        return schedule();
+
+    return Success;
+}
+
 ProcessManager::Result ProcessManager::wait(Process *proc)
 {
     if (m_current->wait(proc->getID()) != Process::Success)
@@ -179,6 +213,8 @@ ProcessManager::Result ProcessManager::wait(Process *proc)
         return IOError;
     }
 
+    proc->m_waiters.append(m_current);
+
     if (m_scheduler.dequeue(m_current) != Scheduler::Success)
     {
         ERROR("process ID " << m_current->getID() << " not removed from Scheduler");
@@ -188,6 +224,14 @@ ProcessManager::Result ProcessManager::wait(Process *proc)
     return Success;
 }
 
+void ProcessManager::cancelWait(Process *proc)
+{
+    Process *other = get(proc->getWait());
+
+    if (other)
+        other->m_waiters.remove(proc);
+}
+
 ProcessManager::Result ProcessManager::sleep(const Timer::Info *timer, bool ignoreWakeups)
 {
     Process::Result result;
@@ -211,9 +255,9 @@ ProcessManager::Result ProcessManager::sleep(const Timer::Info *timer, bool igno
                 return IOError;
             }
 
-            if (timer && (timer->ticks < m_nextSleepTimer.ticks || !m_nextSleepTimer.ticks))
+            if (timer && timer->frequency)
             {
-                MemoryBlock::copy(&m_nextSleepTimer, timer, sizeof(m_nextSleepTimer));
+                m_sleepQueue.insert(m_current);
             }
             break;
 
@@ -231,6 +275,9 @@ ProcessManager::Result ProcessManager::wakeup(Process *proc)
     Process::Result result;
     Process::State state = proc->getState();
 
+    if (state == Process::Waiting)
+        cancelWait(proc);
+
     if ((result = proc->wakeup()) != Process::Success)
     {
         ERROR("failed to wakeup process ID " << proc->getID() <<
@@ -238,6 +285,8 @@ ProcessManager::Result ProcessManager::wakeup(Process *proc)
         return IOError;
     }
 
+    m_sleepQueue.remove(proc);
+
     if (state != Process::Ready)
     {
         if (m_scheduler.enqueue(proc) != Scheduler::Success)
@@ -250,11 +299,25 @@ ProcessManager::Result ProcessManager::wakeup(Process *proc)
     return Success;
 }
 
+ProcessManager::Result ProcessManager::setPriority(Process *proc, Process::Priority priority)
+{
+    if (m_scheduler.setPriority(proc, priority) != Scheduler::Success)
+    {
+        ERROR("failed to set priority of process ID " << proc->getID());
+        return InvalidArgument;
+    }
+
+    return Success;
+}
+
 ProcessManager::Result ProcessManager::raiseEvent(Process *proc, struct ProcessEvent *event)
 {
     Process::Result result;
     Process::State state = proc->getState();
 
+    if (state == Process::Waiting)
+        cancelWait(proc);
+
     if ((result = proc->raiseEvent(event)) != Process::Success)
     {
         ERROR("failed to raise event in process ID " << proc->getID() <<
@@ -262,6 +325,8 @@ ProcessManager::Result ProcessManager::raiseEvent(Process *proc, struct ProcessE
         return IOError;
     }
 
+    m_sleepQueue.remove(proc);
+
     if (state != Process::Ready)
     {
         if (m_scheduler.enqueue(proc) != Scheduler::Success)
@@ -324,6 +389,9 @@ ProcessManager::Result ProcessManager::interruptNotify(u32 vector)
                 return IOError;
             }
         }
+
+        // Let a higher priority process handle the interrupt immediately
+        return preempt();
     }
 
     return Success;
@@ -22,6 +22,7 @@
 #include <MemoryMap.h>
 #include <Vector.h>
 #include <List.h>
+#include <CoreInfo.h>
 #include "Process.h"
 
 /**
@@ -32,6 +33,7 @@
 #define MAX_PROCS 1024
 
 #include "Scheduler.h"
+#include "SleepQueue.h"
 
 /**
  * @addtogroup kernel
@@ -106,6 +108,13 @@ class ProcessManager
      */
     Result schedule();
 
+    /**
+     * Switch to a higher priority Process, if any is ready to run.
+     *
+     * @return Result code
+     */
+    Result preempt();
+
     /**
      * Let current Process wait for another Process to terminate.
      *
@@ -134,6 +143,16 @@ class ProcessManager
      */
     Result wakeup(Process *proc);
 
+    /**
+     * Change the scheduling priority of a Process.
+     *
+     * @param proc Process pointer
+     * @param priority New priority level
+     *
+     * @return Result code
+     */
+    Result setPriority(Process *proc, Process::Priority priority);
+
     /**
      * Raise kernel event for a Process
      *
@@ -177,6 +196,20 @@ class ProcessManager
      */
     void setIdle(Process *proc);
 
+    /**
+     * Set the CoreLoad to publish the load of this core.
+     *
+     * @param load CoreLoad pointer shared with the CoreServer
+     */
+    void setCoreLoad(CoreLoad *load);
+
+    /**
+     * Get the number of processes ready to run.
+     *
+     * @return Number of processes on the schedule
+     */
+    Size getReadyCount() const;
+
     /**
      * Current process running. NULL if no process running yet.
      *
@@ -191,6 +224,15 @@ class ProcessManager
      */
     Vector<Process *> * getProcessTable();
 
+  private:
+
+    /**
+     * Remove a waiting Process from the waiters of the other Process.
+     *
+     * @param proc Process pointer in the Waiting state
+     */
+    void cancelWait(Process *proc);
+
   private:
 
     /** All known Processes. */
@@ -205,8 +247,17 @@ class ProcessManager
     /** Idle process */
     Process *m_idle;
 
-    /** Next timer */
-    Timer::Info m_nextSleepTimer;
+    /** Timer ticks at the start of the current time slice */
+    u32 m_sliceStart;
+
+    /** Timer ticks at the last priority boost */
+    u32 m_boostStart;
+
+    /** Published load of this core, or ZERO if none */
+    CoreLoad *m_coreLoad;
+
+    /** Sleeping processes ordered by their sleep timer */
+    SleepQueue m_sleepQueue;
 
     /** Interrupt notification list */
     Vector<List<Process *> *> m_interruptNotifyList;
@@ -32,28 +32,21 @@ ProcessShares::ProcessShares(ProcessID pid)
 ProcessShares::~ProcessShares()
 {
     ProcessManager *procs = Kernel::instance->getProcessManager();
-    List<ProcessID> pids;
 
     // Cleanup members
     delete m_kernelChannel;
 
-    // Make a list of unique process IDs which
-    // have a share with this Process
+    // Release all memory shares
     Size size = m_shares.size();
     for (Size i = 0; i < size; i++)
     {
         MemoryShare *sh = (MemoryShare *) m_shares.get(i);
         if (sh)
-        {
-            if (!pids.contains(sh->pid))
-                pids.append(sh->pid);
-
             releaseShare(sh, i);
-        }
     }
 
     // Raise process terminated events
-    for (ListIterator<ProcessID> i(pids); i.hasCurrent(); i++)
+    for (ListIterator<ProcessID> i(m_peers); i.hasCurrent(); i++)
     {
         ProcessID pid = i.current();
         Process *proc = procs->get(pid);
@@ -113,6 +106,7 @@ ProcessShares::Result ProcessShares::createShare(ProcessID pid,
 
     // insert into shares list
     m_shares.insert(*share);
+    addPeer(pid);
     return Success;
 }
 
@@ -208,6 +202,8 @@ ProcessShares::Result ProcessShares::createShare(ProcessShares & instance,
     // insert into shares list
     m_shares.insert(*localShare);
     instance.m_shares.insert(*remoteShare);
+    addPeer(localShare->pid);
+    instance.addPeer(remoteShare->pid);
 
     // raise event on the remote process
     ProcessManager *procs = Kernel::instance->getProcessManager();
@@ -238,6 +234,7 @@ ProcessShares::Result ProcessShares::removeShares(ProcessID pid)
             releaseShare(s, i);
         }
     }
+    m_peers.remove(pid);
     return Success;
 }
 
@@ -288,6 +285,12 @@ ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s, Size idx)
     return Success;
 }
 
+void ProcessShares::addPeer(ProcessID pid)
+{
+    if (!m_peers.contains(pid))
+        m_peers.append(pid);
+}
+
 ProcessShares::Result ProcessShares::readShare(MemoryShare *share)
 {
     Size size = m_shares.size();
@@ -162,6 +162,13 @@ class ProcessShares
      */
     Result releaseShare(MemoryShare *share, Size idx);
 
+    /**
+     * Add a process to the list of peers, if not yet known.
+     *
+     * @param pid ProcessID of the peer
+     */
+    void addPeer(ProcessID pid);
+
   private:
 
     /** ProcessID associated to these shares */
@@ -175,6 +182,9 @@ class ProcessShares
 
     /** Contains all memory shares */
     Index<MemoryShare> m_shares;
+
+    /** Unique ProcessIDs which have at least one memory share with us */
+    List<ProcessID> m_peers;
 };
 
 /**
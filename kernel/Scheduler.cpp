@@ -22,11 +22,19 @@
 Scheduler::Scheduler()
 {
     DEBUG("");
+
+    for (Size i = 0; i < SCHEDULER_LEVELS; i++)
+    {
+        m_head[i] = ZERO;
+        m_tail[i] = ZERO;
+    }
+    m_levels = 0;
+    m_count  = 0;
 }
 
 Size Scheduler::count() const
 {
-    return m_queue.count();
+    return m_count;
 }
 
 Scheduler::Result Scheduler::enqueue(Process *proc, bool ignoreState)
@@ -37,7 +45,14 @@ Scheduler::Result Scheduler::enqueue(Process *proc, bool ignoreState)
         return InvalidArgument;
     }
 
-    m_queue.push(proc);
+    if (isQueued(proc))
+    {
+        ERROR("process ID " << proc->getID() << " already in the schedule");
+        return InvalidArgument;
+    }
+
+    // Processes (re)enter the schedule at their own priority
+    link(proc, proc->m_priority);
     return Success;
 }
 
@@ -49,31 +64,145 @@ Scheduler::Result Scheduler::dequeue(Process *proc, bool ignoreState)
         return InvalidArgument;
     }
 
-    Size count = m_queue.count();
-
-    // Traverse the Queue to remove the Process
-    for (Size i = 0; i < count; i++)
+    if (!isQueued(proc))
     {
-        Process *p = m_queue.pop();
-
-        if (p == proc)
+        if (ignoreState)
             return Success;
-        else
-            m_queue.push(p);
+
+        FATAL("process ID " << proc->getID() << " is not in the schedule");
     }
 
-    FATAL("process ID " << proc->getID() << " is not in the schedule");
+    unlink(proc);
+    return Success;
 }
 
 Process * Scheduler::select()
 {
-    if (m_queue.count() > 0)
+    if (!m_levels)
+        return (Process *) NULL;
+
+    // Take the first Process from the highest level and move it to the tail
+    Process::Priority level = (Process::Priority) (31 - __builtin_clz(m_levels));
+    Process *p = m_head[level];
+
+    if (p != m_tail[level])
+    {
+        unlink(p);
+        link(p, level);
+    }
+
+    return p;
+}
+
+Scheduler::Result Scheduler::demote(Process *proc)
+{
+    if (!isQueued(proc))
+    {
+        ERROR("process ID " << proc->getID() << " is not in the schedule");
+        return InvalidArgument;
+    }
+
+    if (proc->m_level > Process::Lowest)
+    {
+        Process::Priority level = (Process::Priority) (proc->m_level - 1);
+        unlink(proc);
+        link(proc, level);
+    }
+
+    return Success;
+}
+
+void Scheduler::boost()
+{
+    // Walk the levels from low to high, such that moved processes are not lowered again
+    for (Size level = Process::Lowest; level < SCHEDULER_LEVELS; level++)
     {
-        Process *p = m_queue.pop();
-        m_queue.push(p);
+        Process *next = ZERO;
 
-        return p;
+        for (Process *p = m_head[level]; p; p = next)
+        {
+            next = p->m_scheduleNext;
+
+            if (p->m_level != p->m_priority)
+            {
+                unlink(p);
+                link(p, p->m_priority);
+            }
+        }
     }
+}
+
+Scheduler::Result Scheduler::setPriority(Process *proc, Process::Priority priority)
+{
+    if (priority < Process::Lowest || priority > Process::Highest)
+    {
+        ERROR("invalid priority " << (uint) priority << " for process ID " << proc->getID());
+        return InvalidArgument;
+    }
+
+    proc->m_priority = priority;
+
+    if (isQueued(proc))
+    {
+        unlink(proc);
+        link(proc, priority);
+    }
+
+    return Success;
+}
+
+bool Scheduler::preempts(const Process *proc) const
+{
+    if (!m_levels)
+        return false;
+
+    Size highest = 31 - __builtin_clz(m_levels);
+
+    if (!isQueued(proc))
+        return true;
+
+    return highest > (Size) proc->m_level;
+}
+
+bool Scheduler::isQueued(const Process *proc) const
+{
+    return proc->m_schedulePrev != ZERO || m_head[proc->m_level] == proc;
+}
+
+void Scheduler::link(Process *proc, Process::Priority level)
+{
+    proc->m_level        = level;
+    proc->m_scheduleNext = ZERO;
+    proc->m_schedulePrev = m_tail[level];
+
+    if (m_tail[level])
+        m_tail[level]->m_scheduleNext = proc;
+    else
+        m_head[level] = proc;
+
+    m_tail[level] = proc;
+    m_levels |= (1 << level);
+    m_count++;
+}
+
+void Scheduler::unlink(Process *proc)
+{
+    Process::Priority level = proc->m_level;
+
+    if (proc->m_schedulePrev)
+        proc->m_schedulePrev->m_scheduleNext = proc->m_scheduleNext;
+    else
+        m_head[level] = proc->m_scheduleNext;
+
+    if (proc->m_scheduleNext)
+        proc->m_scheduleNext->m_schedulePrev = proc->m_schedulePrev;
+    else
+        m_tail[level] = proc->m_schedulePrev;
+
+    if (!m_head[level])
+        m_levels &= ~(1 << level);
 
-    return (Process *) NULL;
+    proc->m_scheduleNext = ZERO;
+    proc->m_schedulePrev = ZERO;
+    m_count--;
 }
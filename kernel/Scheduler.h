@@ -19,11 +19,19 @@
 #define __KERNEL_SCHEDULER_H
 #ifndef __ASSEMBLER__
 
-#include <Vector.h>
+#include <Types.h>
 #include <Macros.h>
-#include <Queue.h>
 #include "Process.h"
 
+/** Number of priority levels in the Scheduler run queue. */
+#define SCHEDULER_LEVELS (Process::Highest + 1)
+
+/** Number of whole timer ticks in a time slice. */
+#define SCHEDULER_SLICE_TICKS 1
+
+/** Number of timer ticks between restoring all processes to their own priority. */
+#define SCHEDULER_BOOST_TICKS 100
+
 /**
  * @addtogroup kernel
  * @{
@@ -31,6 +39,15 @@
 
 /**
  * Responsible for deciding which Process may execute on the local Core.
+ *
+ * The Scheduler keeps a multi-level feedback run queue. Every priority
+ * level is a round-robin list of processes, linked via the Process itself.
+ * Processes enter the run queue at their own priority level and are lowered
+ * one level each time they use up a whole time slice. The highest
+ * non-empty level is found using a bitmap, such that enqueue, dequeue
+ * and select all execute in constant time. To prevent starvation of
+ * lowered processes, boost() periodically moves every process back
+ * to its own priority level.
  */
 class Scheduler
 {
@@ -86,10 +103,78 @@ class Scheduler
      */
     Process * select();
 
+    /**
+     * Lower the run queue level of a Process which used up its time slice.
+     *
+     * @param proc Process pointer
+     *
+     * @return Result code
+     */
+    Result demote(Process *proc);
+
+    /**
+     * Move all processes on the schedule back to their own priority level.
+     */
+    void boost();
+
+    /**
+     * Change the priority of a Process.
+     *
+     * @param proc Process pointer
+     * @param priority New priority level
+     *
+     * @return Result code
+     */
+    Result setPriority(Process *proc, Process::Priority priority);
+
+    /**
+     * Check if a Process with a higher run queue level is ready.
+     *
+     * @param proc Process pointer to compare with
+     *
+     * @return True if the given Process should be preempted, false otherwise
+     */
+    bool preempts(const Process *proc) const;
+
   private:
 
-    /** Contains processes ready to run */
-    Queue<Process *, MAX_PROCS> m_queue;
+    /**
+     * Check if a Process is on the run queue.
+     *
+     * @param proc Process pointer
+     *
+     * @return True if on the run queue, false otherwise
+     */
+    bool isQueued(const Process *proc) const;
+
+    /**
+     * Append a Process to the tail of a run queue level.
+     *
+     * @param proc Process pointer
+     * @param level Run queue level to add the Process to
+     */
+    void link(Process *proc, Process::Priority level);
+
+    /**
+     * Remove a Process from its run queue level.
+     *
+     * @param proc Process pointer
+     */
+    void unlink(Process *proc);
+
+  private:
+
+    /** First Process on each run queue level */
+    Process *m_head[SCHEDULER_LEVELS];
+
+    /** Last Process on each run queue level */
+    Process *m_tail[SCHEDULER_LEVELS];
+
+    /** Bitmap of run queue levels which have at least one Process */
+    u32 m_levels;
+
+    /** Number of processes on the schedule */
+    Size m_count;
 };
 
 /**
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Log.h>
+#include "Kernel.h"
+#include "SleepQueue.h"
+
+SleepQueue::SleepQueue()
+{
+    DEBUG("");
+
+    m_heap[0] = ZERO;
+    m_count   = 0;
+}
+
+Size SleepQueue::count() const
+{
+    return m_count;
+}
+
+SleepQueue::Result SleepQueue::insert(Process *proc)
+{
+    if (proc->m_sleepIndex != 0)
+    {
+        ERROR("process ID " << proc->getID() << " already in the sleep queue");
+        return InvalidArgument;
+    }
+
+    if (m_count >= MAX_PROCS)
+    {
+        ERROR("sleep queue full");
+        return InvalidArgument;
+    }
+
+    place(proc, ++m_count);
+    moveUp(m_count);
+    return Success;
+}
+
+SleepQueue::Result SleepQueue::remove(Process *proc)
+{
+    Size index = proc->m_sleepIndex;
+
+    if (index == 0)
+        return Success;
+
+    Process *last = m_heap[m_count];
+    m_heap[m_count--] = ZERO;
+    proc->m_sleepIndex = 0;
+
+    // Fill the hole with the last entry and restore heap order
+    if (last != proc)
+    {
+        place(last, index);
+        moveUp(index);
+        moveDown(last->m_sleepIndex);
+    }
+
+    return Success;
+}
+
+Process * SleepQueue::head() const
+{
+    return m_count > 0 ? m_heap[1] : ZERO;
+}
+
+void SleepQueue::place(Process *proc, Size index)
+{
+    m_heap[index] = proc;
+    proc->m_sleepIndex = index;
+}
+
+void SleepQueue::moveUp(Size index)
+{
+    Process *proc = m_heap[index];
+
+    while (index > 1 && before(proc, m_heap[index / 2]))
+    {
+        place(m_heap[index / 2], index);
+        index /= 2;
+    }
+    place(proc, index);
+}
+
+void SleepQueue::moveDown(Size index)
+{
+    Process *proc = m_heap[index];
+
+    while (index * 2 <= m_count)
+    {
+        Size child = index * 2;
+
+        if (child < m_count && before(m_heap[child + 1], m_heap[child]))
+            child++;
+
+        if (!before(m_heap[child], proc))
+            break;
+
+        place(m_heap[child], index);
+        index = child;
+    }
+    place(proc, index);
+}
+
+bool SleepQueue::before(const Process *a, const Process *b) const
+{
+    return a->m_sleepTimer.ticks < b->m_sleepTimer.ticks;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_SLEEPQUEUE_H
+#define __KERNEL_SLEEPQUEUE_H
+#ifndef __ASSEMBLER__
+
+#include <Types.h>
+#include <Macros.h>
+#include "Process.h"
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/**
+ * Keeps sleeping processes ordered by the expiry of their sleep timer.
+ *
+ * The SleepQueue is a binary min-heap of processes with the earliest
+ * sleep timer at the head. Each Process stores its own position in the heap,
+ * such that it can be removed on wakeup in logarithmic time.
+ */
+class SleepQueue
+{
+  public:
+
+    /**
+     * Result code
+     */
+    enum Result
+    {
+        Success,
+        InvalidArgument
+    };
+
+  public:
+
+    /**
+     * Constructor function.
+     */
+    SleepQueue();
+
+    /**
+     * Get number of processes in the SleepQueue.
+     *
+     * @return Number of sleeping processes with a timer
+     */
+    Size count() const;
+
+    /**
+     * Add a Process using its current sleep timer.
+     *
+     * @param proc Process pointer
+     *
+     * @return Result code
+     */
+    Result insert(Process *proc);
+
+    /**
+     * Remove a Process.
+     *
+     * @param proc Process pointer
+     *
+     * @return Result code
+     */
+    Result remove(Process *proc);
+
+    /**
+     * Get the Process which has the earliest sleep timer.
+     *
+     * @return Process pointer or ZERO if empty
+     */
+    Process * head() const;
+
+  private:
+
+    /**
+     * Store a Process at the given heap position.
+     *
+     * @param proc Process pointer
+     * @param index Heap position
+     */
+    void place(Process *proc, Size index);
+
+    /**
+     * Move the Process at the given position up, towards the head.
+     *
+     * @param index Heap position
+     */
+    void moveUp(Size index);
+
+    /**
+     * Move the Process at the given position down, away from the head.
+     *
+     * @param index Heap position
+     */
+    void moveDown(Size index);
+
+    /**
+     * Compare the sleep timers of two processes.
+     *
+     * @return True if a expires before b, false otherwise
+     */
+    bool before(const Process *a, const Process *b) const;
+
+  private:
+
+    /** Heap of sleeping processes. The first entry is unused. */
+    Process *m_heap[MAX_PROCS + 1];
+
+    /** Number of processes in the heap */
+    Size m_count;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __ASSEMBLER__ */
+#endif /* __KERNEL_SLEEPQUEUE_H */
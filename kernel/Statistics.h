@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_STATISTICS_H
+#define __KERNEL_STATISTICS_H
+
+#include <FreeNOS/Config.h>
+#include <Types.h>
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/**
+ * Counters for the hot paths of the kernel on a single core.
+ *
+ * The counters are only updated if the kernel is built
+ * with STATISTICS set in build.conf, otherwise they remain zero.
+ */
+typedef struct KernelStatistics
+{
+    /** Number of context switches done by the scheduler. */
+    u64 contextSwitches;
+
+    /** Timestamp cycles spent in ProcessManager::schedule(). */
+    u64 scheduleCycles;
+
+    /** Kernel events dropped because the process channel was full. */
+    u64 channelFull;
+
+    /** Number of pages mapped by VMCopy() for high memory. */
+    u64 copyPages;
+
+    /** Timestamp cycles spent in VMCopy(). */
+    u64 copyCycles;
+}
+KernelStatistics;
+
+#if STATISTICS
+
+/**
+ * Add a value to a kernel statistics counter.
+ *
+ * @param counter Name of the KernelStatistics member.
+ * @param value Value to add.
+ */
+#define STATISTICS_ADD(counter, value) \
+    (Kernel::instance->getStatistics()->counter += (value))
+
+/**
+ * Start measuring cycles for a kernel statistics counter.
+ *
+ * @param name Name of the local variable holding the start timestamp.
+ */
+#define STATISTICS_START(name) \
+    u64 name = timestamp()
+
+/**
+ * Add the cycles passed since STATISTICS_START() to a counter.
+ *
+ * @param counter Name of the KernelStatistics member.
+ * @param name Name of the local variable holding the start timestamp.
+ */
+#define STATISTICS_STOP(counter, name) \
+    STATISTICS_ADD(counter, timestamp() - (name))
+
+#else
+
+#define STATISTICS_ADD(counter, value)   do { } while (0)
+#define STATISTICS_START(name)           do { } while (0)
+#define STATISTICS_STOP(counter, name)   do { } while (0)
+
+#endif /* STATISTICS */
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_STATISTICS_H */
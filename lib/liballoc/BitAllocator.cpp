@@ -17,9 +17,9 @@
 
 #include "BitAllocator.h"
 
-BitAllocator::BitAllocator(Memory::Range range, Size chunkSize)
+BitAllocator::BitAllocator(Memory::Range range, Size chunkSize, u8 *bitmap)
     : Allocator()
-    , m_array(range.size / chunkSize)
+    , m_array(range.size / chunkSize, bitmap)
     , m_base(range.phys)
     , m_chunkSize(chunkSize)
 {
@@ -47,8 +47,9 @@ class BitAllocator : public Allocator
      *
      * @param range Contigeous range of memory to manage.
      * @param chunkSize Total memory will be divided into chunks.
+     * @param bitmap Memory for the chunk bitmap or ZERO to allocate it.
      */
-    BitAllocator(Memory::Range range, Size chunkSize);
+    BitAllocator(Memory::Range range, Size chunkSize, u8 *bitmap = ZERO);
 
     /**
      * Get chunk size.
@@ -39,12 +39,17 @@ Size BubbleAllocator::available() const
 Allocator::Result BubbleAllocator::allocate(Allocator::Arguments & args)
 {
     Size needed = aligned(args.size, MEMALIGN);
+    u8 *start = m_current;
+
+    // Skip memory up to the requested alignment, if any
+    if (args.alignment)
+        start = (u8 *) aligned((Address) m_current, args.alignment);
 
     // Do we still have enough room?
-    if (m_current + needed < m_start + m_size)
+    if (start + needed < m_start + m_size)
     {
-        m_current += needed;
-        args.address = (Address) (m_current - needed);
+        m_current = start + needed;
+        args.address = (Address) start;
         return Success;
     }
     // No more memory available
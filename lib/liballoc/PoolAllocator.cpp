@@ -23,6 +23,8 @@ PoolAllocator::PoolAllocator()
     : Allocator()
 {
     MemoryBlock::set(m_pools, 0, sizeof(m_pools));
+    m_start = ZERO;
+    m_end   = ZERO;
 }
 
 Size PoolAllocator::size() const
@@ -37,89 +39,166 @@ Size PoolAllocator::available() const
 
 Allocator::Result PoolAllocator::allocate(Allocator::Arguments & args)
 {
-    Size index, nPools = 1;
-    MemoryPool *pool = ZERO;
+    Size index = POOL_MIN_POWER;
+    MemoryPool *pool;
 
-    // Find the correct pool size
-    for (index = POOL_MIN_POWER; index < POOL_MAX_POWER; index++)
-    {
-        if (args.size <= (Size) 1 << (index + 1)) break;
-    }
+    // Find the correct pool size: the smallest power of two which fits
+    if (args.size > (1U << (POOL_MIN_POWER + 1)))
+        index = 31 - __builtin_clz(args.size - 1);
 
-    // Do we need to allocate an initial pool?
-    if (!m_pools[index] && m_parent)
+    if (index >= POOL_MAX_POWER - 1)
     {
-        pool = m_pools[index] = newPool(index, POOL_MIN_COUNT(args.size));
+        args.address = ZERO;
+        return OutOfMemory;
     }
-    // Search for pool with enough memory
-    else
+
+    // Allocate new pools if none has free blocks
+    if (!(pool = m_pools[index]) && !(pool = newPool(index)))
     {
-        // Loop current pools
-        for (pool = m_pools[index]; pool; pool = pool->next, nPools++)
-        {
-            // At least one block still free?
-            if (pool->free)
-                break;
-
-            // If no pool has free space anymore, allocate another
-            if (!pool->next)
-            {
-                pool = newPool(index, POOL_MIN_COUNT(args.size) * nPools);
-                break;
-            }
-        }
+        args.address = ZERO;
+        return OutOfMemory;
     }
-    // Attempt to allocate
-    if (pool)
+    args.address = pool->allocate();
+
+    // Remove the pool from the free list when full
+    if (!pool->free)
     {
-        args.address = pool->allocate();
-        return Success;
+        m_pools[index] = pool->next;
+
+        if (pool->next)
+            pool->next->prev = ZERO;
     }
-    args.address = ZERO;
-    return OutOfMemory;
+
+    return Success;
 }
 
-MemoryPool * PoolAllocator::newPool(Size index, Size cnt)
+MemoryPool * PoolAllocator::newPool(Size index)
 {
-    MemoryPool *pool = 0;
     Allocator::Arguments alloc_args;
+    Size blockSize = 1 << (index + 1);
+    Size header = aligned(sizeof(MemoryPool), MEMALIGN);
+    Size poolSize, count;
+
+    if (!m_parent)
+        return ZERO;
+
+    // Small blocks share a single slab. Larger blocks get a pool of their own,
+    // which may leave up to half of the pool memory unused (see class comment).
+    if (blockSize <= (POOL_SLAB_SIZE - header) / 2)
+    {
+        poolSize = POOL_SLAB_SIZE;
+        count    = (POOL_SLAB_SIZE - header) / blockSize;
+    }
+    else
+    {
+        poolSize = aligned(header + blockSize, POOL_SLAB_SIZE);
+        count    = 1;
+    }
+
+    // Ask m_parent for slab aligned memory
+    alloc_args.address   = 0;
+    alloc_args.alignment = POOL_SLAB_SIZE;
+    alloc_args.size      = poolSize;
 
-    // Prepare amount to allocate from m_parent
-    alloc_args.address = 0;
-    alloc_args.alignment = 0;
-    alloc_args.size  = cnt * (1 << (index + 1));
-    alloc_args.size += sizeof(MemoryPool);
-    alloc_args.size += BITMAP_NUM_BYTES(cnt);
-    alloc_args.size += MEMALIGN;
+    if (m_parent->allocate(alloc_args) != Allocator::Success ||
+        alloc_args.address & (POOL_SLAB_SIZE - 1))
+        return ZERO;
 
-    // Ask m_parent for memory, then fill in the pool
-    if (m_parent->allocate(alloc_args) == Allocator::Success)
+    // The parent may return more memory than requested
+    Size num = alloc_args.size / poolSize;
+    if (!num) num++;
+
+    // Fill in the pools
+    for (Size i = 0; i < num; i++)
     {
-        pool = (MemoryPool *) alloc_args.address;
-        pool->count  = cnt;
-        pool->addr   = aligned( ((Address) (pool + 1)) + BITMAP_NUM_BYTES(pool->count), MEMALIGN );
+        MemoryPool *pool = (MemoryPool *) (alloc_args.address + (i * poolSize));
+        Size words = (count + 31) / 32;
+
+        pool->count  = count;
+        pool->addr   = ((Address) pool) + header;
+        pool->size   = blockSize;
+        pool->free   = count;
+        pool->hint   = 0;
+        pool->prev   = ZERO;
         pool->next   = m_pools[index];
-        pool->free   = pool->count;
-        pool->size   = (1 << (index + 1));
+        MemoryBlock::set(pool->blocks, 0, sizeof(pool->blocks));
+
+        if (pool->next)
+            pool->next->prev = pool;
+
+        // Mark the bits beyond the last block as used
+        if (count % 32)
+            pool->blocks[words - 1] = ~((1U << (count % 32)) - 1);
+
         m_pools[index] = pool;
-        MemoryBlock::set(pool->blocks, 0, BITMAP_NUM_BYTES(pool->count));
     }
-    return pool;
+    // Keep track of the memory range of all pools
+    if (!m_start || alloc_args.address < m_start)
+        m_start = alloc_args.address;
+
+    if (alloc_args.address + (num * poolSize) > m_end)
+        m_end = alloc_args.address + (num * poolSize);
+
+    return m_pools[index];
 }
 
 Allocator::Result PoolAllocator::release(Address addr)
 {
-    for (Size i = POOL_MIN_POWER - 1; i < POOL_MAX_POWER; i++)
+    if (addr < m_start || addr >= m_end)
+        return InvalidAddress;
+
+    // The pool header is at the start of the slab
+    MemoryPool *pool = (MemoryPool *) (addr & ~((Address) POOL_SLAB_SIZE - 1));
+
+    if (addr < pool->addr || addr >= pool->addr + (pool->count * pool->size) ||
+        (addr - pool->addr) % pool->size)
+        return InvalidAddress;
+
+    // Put the pool back on the free list if it was full
+    bool full = !pool->free;
+
+    if (!pool->release(addr))
+        return InvalidAddress;
+
+    Size index = 31 - __builtin_clz(pool->size) - 1;
+
+    if (full)
     {
-        for (MemoryPool *p = m_pools[i]; p; p = p->next)
-        {
-            if (addr < p->addr + (p->count * p->size) &&
-                addr >= p->addr)
-            {
-                p->release(addr);
-                return Success;
-            }
-        }
+        pool->prev = ZERO;
+        pool->next = m_pools[index];
+
+        if (pool->next)
+            pool->next->prev = pool;
+
+        m_pools[index] = pool;
     }
-    return InvalidAddress;
+    // Empty pools go back to the parent, if another pool of this size has room
+    if (pool->free == pool->count && (pool->prev || pool->next))
+        reclaimPool(pool, index);
+
+    return Success;
+}
+
+void PoolAllocator::reclaimPool(MemoryPool *pool, Size index)
+{
+    Address base = (Address) pool;
+    Size size = aligned(pool->addr + (pool->count * pool->size), POOL_SLAB_SIZE) - base;
+
+    // Parents which never free memory keep the pool in use.
+    // The header stays intact until the parent reuses the memory.
+    if (m_parent->release(base) != Allocator::Success)
+        return;
+
+    // Remove the pool from the free list
+    if (pool->prev)
+        pool->prev->next = pool->next;
+    else
+        m_pools[index] = pool->next;
+
+    if (pool->next)
+        pool->next->prev = pool->prev;
+
+    // Release the remaining slabs of the pool
+    for (Size i = POOL_SLAB_SIZE; i < size; i += POOL_SLAB_SIZE)
+        m_parent->release(base + i);
 }
@@ -18,6 +18,7 @@
 #ifndef __LIBALLOC_POOLALLOCATOR_H
 #define __LIBALLOC_POOLALLOCATOR_H
 
+#include <FreeNOS/System.h>
 #include <Types.h>
 #include <Macros.h>
 #include "Allocator.h"
@@ -36,25 +37,18 @@
 /** Maximum power of two size a pool can be. */
 #define POOL_MAX_POWER 32
 
-/**
- * Allocate this many blocks per default for the given size.
- *
- * @param size Size of each block.
- */
-#define POOL_MIN_COUNT(size) \
-    (64 / (((size) / 1024 ) + 1)) > 0 ? \
-    (64 / (((size) / 1024 ) + 1)) : 1
+/** Pools start at a multiple of this size, such that masking a block gives its pool. */
+#define POOL_SLAB_SIZE PAGESIZE
 
-/**
- * @brief Calculates the number of bytes needed in a bitmap,
- *        to hold the specified number of elements.
- * @param count Number of elements to hold in the bitmap.
- */
-#define BITMAP_NUM_BYTES(count) \
-    ((count / 8) + 1)
+/** Number of 32-bit words in the bitmap, enough for the smallest blocks. */
+#define POOL_BITMAP_WORDS \
+    (((POOL_SLAB_SIZE / (1 << (POOL_MIN_POWER + 1))) + 31) / 32)
 
 /**
  * Memory pool contains pre-allocated blocks of a certain size (power of two).
+ *
+ * The pool header is stored at the start of its own memory, followed
+ * by the blocks. The first block always starts within the first slab.
  */
 typedef struct MemoryPool
 {
@@ -65,31 +59,20 @@ typedef struct MemoryPool
      */
     Address allocate()
     {
-        Address *ptr;
-        Size num = count / sizeof(Address);
-
-        // At least one
-        if (!num) num++;
+        Size words = (count + 31) / 32;
 
-        // Scan bitmap as fast as possible
-        for (Size i = 0; i < num; i++)
+        // Words before the hint have no free blocks
+        for (Size i = hint; i < words; i++)
         {
-            // Point to the correct offset
-            ptr = (Address *) (&blocks) + i;
-
             // Any blocks free?
-            if (*ptr != (Address) ~ZERO)
+            if (blocks[i] != (u32) ~ZERO)
             {
-                // Find the first free bit
-                for (Size bit = 0; bit < sizeof(Address) * 8; bit++)
-                {
-                    if (!(*ptr & 1 << bit))
-                    {
-                        *ptr |= (1 << bit);
-                        free--;
-                        return addr + (((i * sizeof(Address) * 8) + bit) * size);
-                    }
-                }
+                Size bit = __builtin_ctz(~blocks[i]);
+
+                blocks[i] |= (1U << bit);
+                hint = i;
+                free--;
+                return addr + (((i * 32) + bit) * size);
             }
         }
         // Out of memory
@@ -100,19 +83,32 @@ typedef struct MemoryPool
      * Unmarks the appropriate bit for the given address.
      *
      * @param a Address to unmark.
+     *
+     * @return True if the block was in use, false otherwise.
      */
-    void release(Address a)
+    bool release(Address a)
     {
-        Size index = (a - addr) / size / 8;
-        Size bit   = (a - addr) / size % 8;
+        Size index = (a - addr) / size / 32;
+        u32 bit    = 1U << ((a - addr) / size % 32);
 
+        if (!(blocks[index] & bit))
+            return false;
+
+        blocks[index] &= ~bit;
         free++;
-        blocks[index] &= ~(1 << bit);
+
+        if (index < hint)
+            hint = index;
+
+        return true;
     }
 
-    /** Points to the next pool of this size (if any). */
+    /** Points to the next pool of this size with free blocks (if any). */
     MemoryPool *next;
 
+    /** Points to the previous pool of this size with free blocks (if any). */
+    MemoryPool *prev;
+
     /** Memory address allocated to this pool. */
     Address addr;
 
@@ -125,8 +121,11 @@ typedef struct MemoryPool
     /** Free blocks left. */
     Size free;
 
+    /** First word in the bitmap which may have free blocks. */
+    Size hint;
+
     /** Bitmap which represents free and used blocks. */
-    u8 blocks[];
+    u32 blocks[POOL_BITMAP_WORDS];
 }
 MemoryPool;
 
@@ -135,6 +134,19 @@ MemoryPool;
  *
  * Allocates memory from pools the size of a power of two.
  * Each pool is pre-allocated and has a bitmap representing free blocks.
+ * Pools are aligned on POOL_SLAB_SIZE, such that the owner of a block
+ * is found by masking its address. Only pools with free blocks are kept
+ * on the list of each size, hence both allocate() and release() run in
+ * constant time for all but the largest sizes. Pools which become empty
+ * are returned to the parent, except the last one with free blocks of
+ * each size.
+ *
+ * Blocks larger than half a slab minus the pool header get a pool of
+ * their own, rounded up to whole slabs. With 4K slabs a 2K block thus
+ * costs 4K and a 4K block costs 8K of the parent's memory. Sharing
+ * multi-slab pools between such blocks would need a lookup other than
+ * masking the block address, so frequently allocated objects should
+ * stay well below half a slab.
  */
 class PoolAllocator : public Allocator
 {
@@ -182,19 +194,37 @@ class PoolAllocator : public Allocator
   private:
 
     /**
-     * Creates a new MemoryPool instance.
+     * Creates new MemoryPool instances.
+     *
+     * Fills all memory received from our parent with pools
+     * and puts them on the list of free pools.
      *
      * @param index Index in the pools array.
-     * @param cnt Allocate for this many of blocks from our parent.
      *
      * @return Pointer to a MemoryPool object on success, ZERO on failure.
      */
-    MemoryPool * newPool(Size index, Size cnt);
+    MemoryPool * newPool(Size index);
+
+    /**
+     * Return an empty MemoryPool to the parent.
+     *
+     * The pool is kept if the parent does not accept the memory back.
+     *
+     * @param pool Empty MemoryPool to return.
+     * @param index Index in the pools array.
+     */
+    void reclaimPool(MemoryPool *pool, Size index);
 
   private:
 
-    /** Array of memory pools. Index represents the power of two. */
+    /** Array of pools with free blocks. Index represents the power of two. */
     MemoryPool *m_pools[POOL_MAX_POWER];
+
+    /** Lowest address of all pools. */
+    Address m_start;
+
+    /** End address of all pools. */
+    Address m_end;
 };
 
 /**
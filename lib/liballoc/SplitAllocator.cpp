@@ -74,6 +74,13 @@ Allocator::Result SplitAllocator::release(Address addr)
     return m_alloc->release(addr);
 }
 
+bool SplitAllocator::isLow(Address phys) const
+{
+    return phys >= m_low.phys &&
+           phys < m_low.phys + m_low.size &&
+           phys < m_high.phys;
+}
+
 #ifdef ARM
 void * SplitAllocator::toVirtual(Address phys) const
 {
@@ -111,6 +111,17 @@ class SplitAllocator : public Allocator
      */
     virtual Result release(Address addr);
 
+    /**
+     * Check if a physical address is in low memory.
+     *
+     * Low memory is always mapped in the kernel and accessible via toVirtual().
+     *
+     * @param phys Physical address to check.
+     *
+     * @return True if in low memory, false otherwise.
+     */
+    bool isLow(Address phys) const;
+
     /**
      * Convert the given physical address to lower virtual accessible address.
      */
@@ -31,6 +31,12 @@
 /** Needed by IntelBoot16.S. Depends on sizeof(Memory::Access) which is an emum */
 #define COREINFO_SIZE  (KERNEL_PATHLEN + (8 * 4) + (4 * 4) + (4 * 4))
 
+/** Offset of the CoreLoad page inside the CoreChannel memory of a core */
+#define COREINFO_LOAD_OFFSET (PAGESIZE * 4)
+
+/** Core identifier to let the CoreServer pick the core with the lowest load */
+#define COREINFO_ANY_CORE (~0U)
+
 /**
  * @}
  * @}
@@ -110,6 +116,31 @@ typedef struct CoreInfo
 }
 CoreInfo;
 
+/**
+ * Load of a core, as published by its kernel.
+ *
+ * The kernel of each secondary core writes its CoreLoad to the
+ * page at COREINFO_LOAD_OFFSET in its CoreChannel memory, such that
+ * the CoreServer on the master core can place new processes on
+ * the core with the least load.
+ */
+typedef struct CoreLoad
+{
+    /** Number of processes ready to run on the core */
+    Size runnable;
+
+    bool operator == (const struct CoreLoad & load) const
+    {
+        return runnable == load.runnable;
+    }
+
+    bool operator != (const struct CoreLoad & load) const
+    {
+        return runnable != load.runnable;
+    }
+}
+CoreLoad;
+
 /**
  * Local CoreInfo instance.
  *
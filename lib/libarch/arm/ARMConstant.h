@@ -99,6 +99,9 @@
 /** ARM uses 4K pages. */
 #define PAGESIZE        4096
 
+/** Size of a cache line in bytes (largest of the supported cores). */
+#define CACHELINE_SIZE  64
+
 /**
  * Number of entries in the first-level page table.
  *
@@ -85,6 +85,9 @@
 /** Intel uses 4K pages. */
 #define PAGESIZE        4096
 
+/** Size of a cache line in bytes. */
+#define CACHELINE_SIZE  64
+
 /** Number of entries in the page directory. */
 #define PAGEDIR_MAX     1024
 
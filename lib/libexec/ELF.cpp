@@ -22,7 +22,6 @@
 #include <errno.h>
 #include <unistd.h>
 #include <sys/types.h>
-#include <MemoryBlock.h>
 #include "ELF.h"
 
 ELF::ELF(const u8 *image, Size size)
@@ -80,21 +79,20 @@ ELF::Result ELF::regions(ELF::Region *regions, Size *count) const
         if (segments[i].type != ELF_SEGMENT_LOAD)
             continue;
 
-        regions[c].virt   = segments[i].virtualAddress;
-        regions[c].size   = segments[i].memorySize;
-        regions[c].access = Memory::User | Memory::Readable | Memory::Writable;
-        regions[c].data   = new u8[segments[i].memorySize];
-
-        // Read segment contents from file
-        MemoryBlock::copy(regions[c].data, m_image + segments[i].offset,
-                          segments[i].fileSize);
-
-        // Nulify remaining space
-        if (segments[i].memorySize > segments[i].fileSize)
+        // File contents must be inside the image and fit in memory
+        if (segments[i].fileSize > segments[i].memorySize ||
+            segments[i].offset > m_size ||
+            segments[i].fileSize > m_size - segments[i].offset)
         {
-            memset(regions[c].data + segments[i].fileSize, 0,
-                   segments[i].memorySize - segments[i].fileSize);
+            return InvalidFormat;
         }
+
+        // Point to the segment contents in the image. No copy is made.
+        regions[c].virt     = segments[i].virtualAddress;
+        regions[c].size     = segments[i].memorySize;
+        regions[c].access   = Memory::User | Memory::Readable | Memory::Writable;
+        regions[c].data     = (u8 *) m_image + segments[i].offset;
+        regions[c].dataSize = segments[i].fileSize;
         c++;
     }
 
@@ -58,6 +58,9 @@ class ExecutableFormat
         Size size;
         Memory::Access access;
         u8 *data;
+
+        /** Number of bytes in data. The rest of the region is zero-filled. */
+        Size dataSize;
     }
     Region;
 
@@ -90,6 +93,9 @@ class ExecutableFormat
     /**
      * Memory regions a program needs at runtime.
      *
+     * Region data points inside the program image, which must
+     * remain valid while the regions are in use.
+     *
      * @param regions Memory regions to fill.
      * @param count On input, the maximum number of regions to read.
      *              On output, the actual number of regions read.
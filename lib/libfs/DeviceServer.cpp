@@ -29,6 +29,9 @@ DeviceServer::~DeviceServer()
 
 Error DeviceServer::initialize()
 {
+    // Devices must be serviced before any (batch) user processes
+    ProcessCtl(SELF, SetPriority, Process::High);
+
     setRoot(new Directory());
     mount();
     return ESUCCESS;
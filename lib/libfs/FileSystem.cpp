@@ -32,6 +32,7 @@ FileSystem::FileSystem(const char *path)
     m_root      = 0;
     m_mountPath = path;
     m_requests  = new List<FileSystemRequest *>();
+    m_handleGeneration = 0;
         
     // Register message handlers
     addIPCHandler(CreateFile, &FileSystem::pathHandler, false);
@@ -39,6 +40,8 @@ FileSystem::FileSystem(const char *path)
     addIPCHandler(DeleteFile, &FileSystem::pathHandler, false);
     addIPCHandler(ReadFile,   &FileSystem::pathHandler, false);
     addIPCHandler(WriteFile,  &FileSystem::pathHandler, false);
+    addIPCHandler(OpenFile,   &FileSystem::pathHandler, false);
+    addIPCHandler(CloseFile,  &FileSystem::pathHandler, false);
 }
 
 FileSystem::~FileSystem()
@@ -134,8 +137,20 @@ Error FileSystem::registerFile(File *file, const char *path, va_list args)
 
 void FileSystem::pathHandler(FileSystemMessage *msg)
 {
+    u8 *shared = ZERO;
+
+    // Locate the data in the shared data window
+    if (msg->shared && !(shared = findShare(msg)))
+    {
+        ERROR("invalid shared buffer: from = " << msg->from << " offset = " <<
+              (Size) msg->buffer << " size = " << msg->size);
+        msg->result = EFAULT;
+        sendResponse(msg);
+        return;
+    }
+
     // Copy the request
-    FileSystemRequest *req = new FileSystemRequest(msg);
+    FileSystemRequest *req = new FileSystemRequest(msg, shared);
 
     // Process the request.
     if (processRequest(req) == EAGAIN)
@@ -152,10 +167,33 @@ Error FileSystem::processRequest(FileSystemRequest *req)
     File *file = ZERO;
     Directory *parent;
     FileSystemMessage *msg = req->getMessage();
+    FileHandle *handle;
     Error ret;
-    
+
+    // Close an open file handle
+    if (msg->action == CloseFile)
+    {
+        msg->result = closeHandle(msg->from, msg->handle) ? ESUCCESS : EBADF;
+        DEBUG(m_self << ": close = " << (int)msg->result);
+        sendResponse(msg);
+        return msg->result;
+    }
+
+    // Use the open file handle, which must still be valid for the sender.
+    // Otherwise fall back to resolving the path.
+    if (msg->handle && (msg->action == ReadFile || msg->action == WriteFile))
+    {
+        if (!(handle = findHandle(msg->from, msg->handle)))
+        {
+            msg->result = EBADF;
+            sendResponse(msg);
+            return msg->result;
+        }
+        cache = handle->cache;
+        file  = cache->file;
+    }
     // Copy the file path
-    if ((msg->result = VMCopy(msg->from, API::Read, (Address) buf,
+    else if ((msg->result = VMCopy(msg->from, API::Read, (Address) buf,
                     (Address) msg->path, PATHLEN)) <= 0)
     {
         ERROR("path missing: result = " << (int)msg->result << " from = " << msg->from <<
@@ -163,27 +201,31 @@ Error FileSystem::processRequest(FileSystemRequest *req)
         msg->type = ChannelMessage::Response;
         msg->result = EACCES;
         m_registry->getProducer(msg->from)->write(msg);
+        ProcessCtl(msg->from, Resume, 0);
         return msg->result;
     }
-    DEBUG(m_self << ": path = " << buf << " action = " << msg->action);
+    else
+    {
+        DEBUG(m_self << ": path = " << buf << " action = " << msg->action);
 
-    path.parse(buf + strlen(m_mountPath));
+        path.parse(buf + strlen(m_mountPath));
 
-    // Do we have this file cached?
-    if ((cache = findFileCache(&path)) ||
-        (cache = lookupFile(&path)))
-    {
-        file = cache->file;
-    }
-    // File not found
-    else if (msg->action != CreateFile)
-    {
-        DEBUG(m_self << ": not found");
-        msg->type = ChannelMessage::Response;
-        msg->result = ENOENT;
-        m_registry->getProducer(msg->from)->write(msg);
-        ProcessCtl(msg->from, Resume, 0);
-        return msg->result;
+        // Do we have this file cached?
+        if ((cache = findFileCache(&path)) ||
+            (cache = lookupFile(&path)))
+        {
+            file = cache->file;
+        }
+        // File not found
+        else if (msg->action != CreateFile)
+        {
+            DEBUG(m_self << ": not found");
+            msg->type = ChannelMessage::Response;
+            msg->result = ENOENT;
+            m_registry->getProducer(msg->from)->write(msg);
+            ProcessCtl(msg->from, Resume, 0);
+            return msg->result;
+        }
     }
 
     // Perform I/O on the file
@@ -220,6 +262,7 @@ Error FileSystem::processRequest(FileSystemRequest *req)
         case DeleteFile:
             if (cache->entries.count() == 0)
             {
+                closeHandles(cache);
                 clearFileCache(cache);
                 msg->result = ESUCCESS;
             }
@@ -233,6 +276,16 @@ Error FileSystem::processRequest(FileSystemRequest *req)
             DEBUG(m_self << ": stat = " << (int)msg->result);
             break;
 
+        case OpenFile:
+            msg->result = file->status(msg);
+            if (msg->result == ESUCCESS)
+                msg->handle = openHandle(msg->from, cache);
+            DEBUG(m_self << ": open = " << (int)msg->result << " handle = " << msg->handle);
+            break;
+
+        case CloseFile:
+            break;
+
         case ReadFile:
             {
                 msg->result = file->read(req->getBuffer(), msg->size, msg->offset);
@@ -302,6 +355,125 @@ bool FileSystem::retryRequests()
     return restartNeeded;
 }
 
+void FileSystem::processTerminated(ProcessID pid)
+{
+    // Drop parked requests, which may point into the shared window
+    for (ListIterator<FileSystemRequest *> i(m_requests); i.hasCurrent();)
+    {
+        if (i.current()->getMessage()->from == pid)
+        {
+            delete i.current();
+            i.remove();
+        }
+        else
+            i++;
+    }
+
+    m_shares.remove(pid);
+
+    for (Size i = 0; i < m_handles.size(); i++)
+    {
+        const FileHandle *h = m_handles.get(i);
+
+        if (h && h->pid == pid)
+        {
+            m_handles.remove(i);
+            delete h;
+        }
+    }
+}
+
+u8 * FileSystem::findShare(const FileSystemMessage *msg)
+{
+    const FileShare *s = m_shares.get(msg->from);
+    Size offset = (Size) msg->buffer;
+
+    if (!s)
+    {
+        SystemInformation info;
+        ProcessShares::MemoryShare share;
+        FileShare fs;
+
+        share.pid    = msg->from;
+        share.coreId = info.coreId;
+        share.tagId  = FILESYSTEM_SHARE_TAG;
+
+        if (VMShare(msg->from, API::Read, &share) != API::Success)
+            return ZERO;
+
+        fs.base = share.range.virt;
+        fs.size = share.range.size;
+        m_shares.insert(msg->from, fs);
+        s = m_shares.get(msg->from);
+    }
+
+    if (offset > s->size || msg->size > s->size - offset)
+        return ZERO;
+
+    return (u8 *) s->base + offset;
+}
+
+Size FileSystem::openHandle(ProcessID pid, FileCache *cache)
+{
+    FileHandle *h = new FileHandle;
+    int position;
+
+    h->pid   = pid;
+    h->cache = cache;
+    h->generation = ++m_handleGeneration & ((Size) ~0 >> FILESYSTEM_HANDLE_BITS);
+
+    if ((position = m_handles.insert(*h)) < 0)
+    {
+        delete h;
+        return 0;
+    }
+    if ((Size) position + 1 >= (1U << FILESYSTEM_HANDLE_BITS))
+    {
+        m_handles.remove(position);
+        delete h;
+        return 0;
+    }
+    return (h->generation << FILESYSTEM_HANDLE_BITS) | (position + 1);
+}
+
+FileSystem::FileHandle * FileSystem::findHandle(ProcessID pid, Size handle)
+{
+    const Size position = handle & ((1U << FILESYSTEM_HANDLE_BITS) - 1);
+    const FileHandle *h;
+
+    if (!position || !(h = m_handles.get(position - 1)) || h->pid != pid ||
+        h->generation != (handle >> FILESYSTEM_HANDLE_BITS))
+        return ZERO;
+
+    return (FileHandle *) h;
+}
+
+bool FileSystem::closeHandle(ProcessID pid, Size handle)
+{
+    FileHandle *h = findHandle(pid, handle);
+
+    if (!h)
+        return false;
+
+    m_handles.remove((handle & ((1U << FILESYSTEM_HANDLE_BITS) - 1)) - 1);
+    delete h;
+    return true;
+}
+
+void FileSystem::closeHandles(FileCache *cache)
+{
+    for (Size i = 0; i < m_handles.size(); i++)
+    {
+        const FileHandle *h = m_handles.get(i);
+
+        if (h && h->cache == cache)
+        {
+            m_handles.remove(i);
+            delete h;
+        }
+    }
+}
+
 void FileSystem::setRoot(Directory *newRoot)
 {
     m_root = new FileCache(newRoot, "/", ZERO);
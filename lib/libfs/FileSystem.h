@@ -21,6 +21,8 @@
 #include <FreeNOS/System.h>
 #include <ChannelServer.h>
 #include <Vector.h>
+#include <Index.h>
+#include <HashTable.h>
 #include "Directory.h"
 #include "Device.h"
 #include "File.h"
@@ -37,6 +39,9 @@
  * @{
  */
 
+/** Number of bits in a file handle which hold the handle position. */
+#define FILESYSTEM_HANDLE_BITS 16
+
 /**
  * Abstract filesystem class.
  */
@@ -160,8 +165,127 @@ class FileSystem : public ChannelServer<FileSystem, FileSystemMessage>
      */
     virtual bool retryRequests();
 
+    /**
+     * Called when a process has terminated
+     *
+     * Releases all open file handles and the shared data window of the process.
+     *
+     * @param pid ProcessID of the terminated process
+     */
+    virtual void processTerminated(ProcessID pid);
+
   protected:
 
+    /**
+     * Open file handle.
+     */
+    typedef struct FileHandle
+    {
+        /** Process which opened the file. */
+        ProcessID pid;
+
+        /** Cached file entry. */
+        FileCache *cache;
+
+        /** Generation number, to detect reuse of the handle slot. */
+        Size generation;
+
+        /**
+         * Comparison operator.
+         */
+        bool operator == (const struct FileHandle & h) const
+        {
+            return pid == h.pid && cache == h.cache;
+        }
+
+        /**
+         * Inequality operator.
+         */
+        bool operator != (const struct FileHandle & h) const
+        {
+            return pid != h.pid || cache != h.cache;
+        }
+    }
+    FileHandle;
+
+    /**
+     * Shared data window of a client.
+     */
+    typedef struct FileShare
+    {
+        /** Virtual address of the window in our address space. */
+        Address base;
+
+        /** Size of the window in bytes. */
+        Size size;
+
+        /**
+         * Comparison operator.
+         */
+        bool operator == (const struct FileShare & s) const
+        {
+            return base == s.base && size == s.size;
+        }
+
+        /**
+         * Inequality operator.
+         */
+        bool operator != (const struct FileShare & s) const
+        {
+            return base != s.base || size != s.size;
+        }
+    }
+    FileShare;
+
+    /**
+     * Get the request data in the shared data window of the sender.
+     *
+     * Looks up the window with VMShare on first use and caches it.
+     *
+     * @param msg Request with a shared buffer.
+     *
+     * @return Pointer to the request data or ZERO if the
+     *         window does not exist or the request exceeds it.
+     */
+    u8 * findShare(const FileSystemMessage *msg);
+
+    /**
+     * Allocate a new open file handle.
+     *
+     * @param pid Process which opens the file.
+     * @param cache FileCache of the file.
+     *
+     * @return Handle number on success or zero on failure.
+     */
+    Size openHandle(ProcessID pid, FileCache *cache);
+
+    /**
+     * Lookup an open file handle.
+     *
+     * @param pid Process which owns the handle.
+     * @param handle Handle number.
+     *
+     * @return FileHandle pointer or ZERO if not valid for the process.
+     */
+    FileHandle * findHandle(ProcessID pid, Size handle);
+
+    /**
+     * Release an open file handle.
+     *
+     * @param pid Process which owns the handle.
+     * @param handle Handle number.
+     *
+     * @return True if released, false if not valid for the process.
+     */
+    bool closeHandle(ProcessID pid, Size handle);
+
+    /**
+     * Release all open file handles referring to a FileCache.
+     *
+     * @param cache FileCache which is about to be removed.
+     */
+    void closeHandles(FileCache *cache);
+
     /**
      * Process a FileSystemRequest.
      *
@@ -258,6 +382,18 @@ class FileSystem : public ChannelServer<FileSystem, FileSystemMessage>
 
     /** Contains ongoing requests */
     List<FileSystemRequest *> *m_requests;
+
+    /**
+     * Open file handles. The lower FILESYSTEM_HANDLE_BITS of a handle
+     * number are the position plus one, the upper bits its generation.
+     */
+    Index<FileHandle> m_handles;
+
+    /** Generation number of the last opened file handle. */
+    Size m_handleGeneration;
+
+    /** Shared data windows per client process. */
+    HashTable<ProcessID, FileShare> m_shares;
 };
 
 /**
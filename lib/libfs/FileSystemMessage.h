@@ -33,6 +33,15 @@
  * @{
  */
 
+/** VMShare tag of the data window between a client and a FileSystem. */
+#define FILESYSTEM_SHARE_TAG  1
+
+/** Size of the shared data window. */
+#define FILESYSTEM_SHARE_SIZE (PAGESIZE * 16)
+
+/** Minimum transfer size which uses the shared data window. */
+#define FILESYSTEM_SHARE_MIN  PAGESIZE
+
 /**
  * Actions which may be performed on the filesystem.
  */
@@ -42,7 +51,9 @@ typedef enum FileSystemAction
     ReadFile,
     WriteFile,
     StatFile,
-    DeleteFile
+    DeleteFile,
+    OpenFile,
+    CloseFile
 }
 FileSystemAction;
 
@@ -51,6 +62,17 @@ FileSystemAction;
  */
 typedef struct FileSystemMessage : public ChannelMessage
 {
+    /**
+     * Default constructor.
+     *
+     * Starts without an open file handle and without the shared
+     * data window, such that requests which do not set them use
+     * path-based access and copy the buffer with VMCopy.
+     */
+    FileSystemMessage() : handle(0), shared(false)
+    {
+    }
+
     /**
      * Assignment operator.
      * @param m FileSystemMessage pointer to copy from.
@@ -71,6 +93,8 @@ typedef struct FileSystemMessage : public ChannelMessage
         mode        = m->mode;
         stat        = m->stat;
         path        = m->path;
+        handle      = m->handle;
+        shared      = m->shared;
         filetype    = m->filetype;
     }
 
@@ -108,6 +132,17 @@ typedef struct FileSystemMessage : public ChannelMessage
     /** Path name of the file. */
     char *path;
 
+    /**
+     * Server-side handle of an opened file.
+     *
+     * Filled in by OpenFile. When non-zero, I/O requests use the handle
+     * instead of resolving the path again. Zero means path-based access.
+     */
+    Size handle;
+
+    /** If true, buffer is an offset in the shared data window. */
+    bool shared;
+
     /** User ID and group ID. */
     u16 userID, groupID;
 
@@ -63,41 +63,45 @@ FileSystemPath::~FileSystemPath()
 
 void FileSystemPath::parse(const char *p, char sep)
 {
-    const char *cur   = p;
-    char *parentStr   = ZERO;
+    const char *cur = p;
+    char separator[2] = { sep, ZERO };
+    char *buf;
 
     // Skip heading separators
     while (*cur && *cur == sep) cur++;
 
     // Save parameters
-    p            = (char *) cur;
     m_separator  = sep;
     m_fullLength = strlen((char *)cur);
     m_fullPath   = new String(cur);
-    String str(p);
+
+    // Keep a single copy of the path with the separators replaced
+    // by ZERO bytes. The parts then reference it without copying.
+    m_buffer = cur;
+    buf = *m_buffer;
+
+    for (Size i = 0; i < m_fullLength; i++)
+        if (buf[i] == sep)
+            buf[i] = ZERO;
 
     // Split the path into parts
-    List<String> parts = str.split(sep);
-    for (ListIterator<String> i(parts); i.hasCurrent(); i++)
-        m_path.append(new String(i.current()));
+    for (Size i = 0; i < m_fullLength; i++)
+        if (buf[i] && (i == 0 || !buf[i - 1]))
+            m_path.append(new String((const char *) buf + i));
 
     // Create parent, if any
     if (m_path.head() && m_path.head()->next)
     {
-        // Allocate buffer
-        parentStr  = new char[strlen(p)];
-        memset(parentStr, 0, strlen(p));
+        m_parentPath = new String();
 
         // Construct parent path
         for (List<String *>::Node *l = m_path.head(); l && l->next; l = l->next)
         {
-            strcat(parentStr, **l->data);
+            *m_parentPath << **l->data;
+
             if (l->next && l->next->next)
-                strncat(parentStr, &m_separator, 1);
+                *m_parentPath << separator;
         }
-        // Save the path, then release buffer
-        m_parentPath = new String(parentStr);
-        delete parentStr;
     }
 }
 
@@ -121,6 +121,9 @@ class FileSystemPath
     /** Full input path. */
     String *m_fullPath;
 
+    /** Copy of the path with each separator replaced by a ZERO byte. */
+    String m_buffer;
+
     /** Full length of the given path. */
     Size m_fullLength;
 
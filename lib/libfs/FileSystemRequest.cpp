@@ -17,10 +17,10 @@
 
 #include "FileSystemRequest.h"
 
-FileSystemRequest::FileSystemRequest(FileSystemMessage *msg)
+FileSystemRequest::FileSystemRequest(FileSystemMessage *msg, u8 *shared)
 {
     m_msg = msg;
-    m_ioBuffer = new IOBuffer(&m_msg);
+    m_ioBuffer = new IOBuffer(&m_msg, shared);
 }
 
 FileSystemRequest::~FileSystemRequest()
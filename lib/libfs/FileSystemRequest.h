@@ -38,8 +38,11 @@ class FileSystemRequest
 
     /**
      * Constructor
+     *
+     * @param msg Message that was received.
+     * @param shared Optional request data in the shared data window.
      */
-    FileSystemRequest(FileSystemMessage *msg);
+    FileSystemRequest(FileSystemMessage *msg, u8 *shared = ZERO);
 
     /**
      * Destructor
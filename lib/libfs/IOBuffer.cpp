@@ -17,22 +17,19 @@
 
 #include "IOBuffer.h"
 
-IOBuffer::IOBuffer(const FileSystemMessage *msg)
+IOBuffer::IOBuffer(const FileSystemMessage *msg, u8 *shared)
     : m_message(msg)
+    , m_buffer(shared)
+    , m_shared(shared)
 {
-    if (msg->action == ReadFile || msg->action == WriteFile)
-        m_buffer = new u8[msg->size];
-    else
-        m_buffer = 0;
-
     m_size   = msg->size;
     m_count  = 0;
 }
 
 IOBuffer::~IOBuffer()
 {
-    if (m_buffer)
-        delete m_buffer;
+    if (m_buffer && m_buffer != m_shared)
+        delete[] m_buffer;
 }
 
 Size IOBuffer::getCount() const
@@ -52,7 +49,16 @@ const u8 * IOBuffer::getBuffer() const
 
 Error IOBuffer::bufferedRead()
 {
-    m_count = read(m_buffer, m_message->size, 0);
+    // Shared data is already in place
+    if (m_shared)
+    {
+        m_count = m_size;
+        return m_count;
+    }
+    if (!m_buffer)
+        m_buffer = new u8[m_size];
+
+    m_count = read(m_buffer, m_size, 0);
     return m_count;
 }
 
@@ -61,7 +67,7 @@ Error IOBuffer::bufferedWrite(const void *buffer, Size size)
     Size i = 0;
 
     if (!m_buffer)
-        m_buffer = new u8[m_message->size];
+        m_buffer = new u8[m_size];
 
     for (i = 0; i < size && m_count < m_size; i++)
     {
@@ -72,6 +78,16 @@ Error IOBuffer::bufferedWrite(const void *buffer, Size size)
 
 Error IOBuffer::read(void *buffer, Size size, Size offset) const
 {
+    if (m_shared)
+    {
+        if (offset >= m_size)
+            return 0;
+        if (size > m_size - offset)
+            size = m_size - offset;
+
+        MemoryBlock::copy(buffer, m_shared + offset, size);
+        return size;
+    }
     return VMCopy(m_message->from, API::Read,
                  (Address) buffer,
                  (Address) m_message->buffer + offset, size);
@@ -79,6 +95,16 @@ Error IOBuffer::read(void *buffer, Size size, Size offset) const
 
 Error IOBuffer::write(void *buffer, Size size, Size offset) const
 {
+    if (m_shared)
+    {
+        if (offset >= m_size)
+            return 0;
+        if (size > m_size - offset)
+            size = m_size - offset;
+
+        MemoryBlock::copy(m_shared + offset, buffer, size);
+        return size;
+    }
     return VMCopy(m_message->from, API::Write,
                  (Address) buffer,
                  (Address) m_message->buffer + offset, size);
@@ -86,10 +112,14 @@ Error IOBuffer::write(void *buffer, Size size, Size offset) const
 
 Error IOBuffer::flush() const
 {
+    // Buffered data was written directly in the shared data window
+    if (m_buffer == m_shared)
+        return m_count;
+
     return write(m_buffer, m_count, 0);
 }
 
 u8 IOBuffer::operator[](Size index) const
 {
-    return index < m_size ? m_buffer[index] : 0;
+    return m_buffer && index < m_size ? m_buffer[index] : 0;
 }
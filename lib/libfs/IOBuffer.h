@@ -41,8 +41,11 @@ class IOBuffer
      * Constructor.
      *
      * @param msg Describes the request being processed.
+     * @param shared Optional pointer to the request data inside the
+     *               shared data window of the client. If set, I/O
+     *               operates directly on it instead of using VMCopy.
      */
-    IOBuffer(const FileSystemMessage *msg);
+    IOBuffer(const FileSystemMessage *msg, u8 *shared = ZERO);
 
     /**
      * Destructor.
@@ -143,6 +146,9 @@ class IOBuffer
     /** Buffer for storing temporary data. */
     u8 *m_buffer;
 
+    /** Request data in the shared data window, if any. */
+    u8 *m_shared;
+
     /** Buffer size. */
     Size m_size;
 
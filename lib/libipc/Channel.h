@@ -118,6 +118,28 @@ class Channel
      */
     virtual Result write(void *buffer) = 0;
 
+    /**
+     * Read multiple messages.
+     *
+     * @param buffer Output buffer for the messages.
+     * @param count On input the maximum number of messages to read,
+     *              on output the number of messages read.
+     *
+     * @return Result code.
+     */
+    virtual Result readMany(void *buffer, Size *count) = 0;
+
+    /**
+     * Write multiple messages.
+     *
+     * @param buffer Input buffer with the messages.
+     * @param count On input the number of messages to write,
+     *              on output the number of messages written.
+     *
+     * @return Result code.
+     */
+    virtual Result writeMany(void *buffer, Size *count) = 0;
+
     /**
      * Flush message buffers.
      *
@@ -23,12 +23,31 @@
 
 ChannelClient::ChannelClient()
     : Singleton<ChannelClient>(this)
+    , m_requests(CHANNELCLIENT_REQUESTS)
 {
     m_registry = 0;
+    m_freeRequest = CHANNELCLIENT_NO_REQUEST;
+
+    // Preallocate request slots with buffers for filesystem messages
+    for (Size i = 0; i < CHANNELCLIENT_REQUESTS; i++)
+    {
+        Request *req = new Request;
+        req->active  = false;
+        req->size    = sizeof(FileSystemMessage);
+        req->message = (ChannelMessage *) new u8[req->size];
+        m_requests.insert(req);
+        releaseRequest(i);
+    }
 }
 
 ChannelClient::~ChannelClient()
 {
+    for (Size i = 0; i < m_requests.count(); i++)
+    {
+        Request *req = m_requests.at(i);
+        delete[] (u8 *) req->message;
+        delete req;
+    }
 }
 
 ChannelRegistry * ChannelClient::getRegistry()
@@ -47,11 +66,14 @@ ChannelClient::Result ChannelClient::initialize()
     return Success;
 }
 
-ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
+ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize, Size ringSize)
 {
     Address prodAddr, consAddr;
     SystemInformation info;
 
+    if (!ringSize || (ringSize % PAGESIZE))
+        return InvalidSize;
+
     // Allocate consumer
     MemoryChannel *cons = new MemoryChannel;
     if (!cons)
@@ -75,8 +97,8 @@ ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
     ProcessShares::MemoryShare share;
     share.pid    = pid;
     share.coreId = info.coreId;
-    share.tagId  = 0;
-    share.range.size = PAGESIZE * 4;
+    share.tagId  = CHANNELCLIENT_SHARE_TAG;
+    share.range.size = (ringSize + PAGESIZE) * 2;
     share.range.virt = 0;
     share.range.phys = 0;
     share.range.access = Memory::User | Memory::Readable | Memory::Writable;
@@ -88,12 +110,12 @@ ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
         case API::Success:
         {
             prodAddr = share.range.virt;
-            consAddr = share.range.virt + (PAGESIZE * 2);
+            consAddr = share.range.virt + (share.range.size / 2);
             break;
         }
         case API::AlreadyExists:
         {
-            prodAddr = share.range.virt + (PAGESIZE * 2);
+            prodAddr = share.range.virt + (share.range.size / 2);
             consAddr = share.range.virt;
             break;
         }
@@ -103,8 +125,11 @@ ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
         }
     }
 
+    // An existing share determines the ring size
+    ringSize = (share.range.size / 2) - PAGESIZE;
+
     // Setup producer memory address
-    if (prod->setVirtual(prodAddr, prodAddr + PAGESIZE) != MemoryChannel::Success)
+    if (prod->setVirtual(prodAddr, prodAddr + ringSize, ringSize) != MemoryChannel::Success)
     {
         delete prod;
         delete cons;
@@ -112,7 +137,7 @@ ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
     }
 
     // Setup consumer memory address
-    if (cons->setVirtual(consAddr, consAddr + PAGESIZE) != MemoryChannel::Success)
+    if (cons->setVirtual(consAddr, consAddr + ringSize, ringSize) != MemoryChannel::Success)
     {
         delete prod;
         delete cons;
@@ -148,23 +173,12 @@ ChannelClient::Result ChannelClient::sendRequest(ProcessID pid,
     if (!ch)
         return NotFound;
 
-    // Find request object
-    for (Size i = 0; i < m_requests.count(); i++)
-    {
-        req = (Request *) m_requests.get(i);
-        if (!req->active)
-        {
-            identifier = i;
-            break;
-        }
-    }
-    // Allocate new request object if none available
-    if (!req || req->active)
-    {
-        req = new Request;
-        req->message = (ChannelMessage *) new u8[ch->getMessageSize()];
-        identifier   = m_requests.insert(*req);
-    }
+    // Take a request object from the free list
+    if ((identifier = allocateRequest(ch->getMessageSize())) == CHANNELCLIENT_NO_REQUEST)
+        return OutOfMemory;
+
+    req = m_requests.at(identifier);
+
     // Fill request object
     MemoryBlock::copy(req->message, buffer, ch->getMessageSize());
     req->pid = pid;
@@ -178,7 +192,7 @@ ChannelClient::Result ChannelClient::sendRequest(ProcessID pid,
     // Try to send the message
     if (ch->write(req->message) != Channel::Success)
     {
-        req->active = false;
+        releaseRequest(identifier);
         return IOError;
     }
     // Wakeup the receiver
@@ -189,22 +203,69 @@ ChannelClient::Result ChannelClient::sendRequest(ProcessID pid,
 ChannelClient::Result ChannelClient::processResponse(ProcessID pid,
                                                      ChannelMessage *msg)
 {
-    Size count = m_requests.count();
+    // The identifier is the index of the request slot
+    if (msg->identifier >= m_requests.count())
+        return NotFound;
+
+    Request *req = m_requests.at(msg->identifier);
 
-    for (Size i = 0; i < count; i++)
+    if (req->active && req->pid == pid)
     {
-        Request *req = (Request *) m_requests.get(i);
+        req->callback->execute(msg);
+        releaseRequest(msg->identifier);
+        return Success;
+    }
+    return NotFound;
+}
 
-        if (req->active &&
-            req->pid == pid &&
-            req->message->identifier == msg->identifier)
+Size ChannelClient::allocateRequest(Size size)
+{
+    Request *req;
+    Size identifier = m_freeRequest;
+
+    // Allocate a new slot if none available
+    if (identifier == CHANNELCLIENT_NO_REQUEST)
+    {
+        req = new Request;
+        if (!req)
+            return CHANNELCLIENT_NO_REQUEST;
+
+        req->size    = sizeof(FileSystemMessage);
+        req->message = (ChannelMessage *) new u8[req->size];
+
+        int pos = m_requests.insert(req);
+        if (pos < 0)
         {
-            req->callback->execute(msg);
-            req->active = false;
-            return Success;
+            delete[] (u8 *) req->message;
+            delete req;
+            return CHANNELCLIENT_NO_REQUEST;
         }
+        identifier = pos;
     }
-    return NotFound;
+    else
+    {
+        req = m_requests.at(identifier);
+        m_freeRequest = req->nextFree;
+    }
+
+    // Grow the buffer for larger messages
+    if (req->size < size)
+    {
+        delete[] (u8 *) req->message;
+        req->size    = size;
+        req->message = (ChannelMessage *) new u8[req->size];
+    }
+    req->active = true;
+    return identifier;
+}
+
+void ChannelClient::releaseRequest(Size identifier)
+{
+    Request *req = m_requests.at(identifier);
+
+    req->active   = false;
+    req->nextFree = m_freeRequest;
+    m_freeRequest = identifier;
 }
 
 
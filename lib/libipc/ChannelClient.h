@@ -20,7 +20,7 @@
 
 #include <Singleton.h>
 #include <Callback.h>
-#include <Index.h>
+#include <Vector.h>
 #include "ChannelRegistry.h"
 #include "Channel.h"
 #include "ChannelMessage.h"
@@ -34,8 +34,21 @@
  * @{
  */
 
+/** Number of request slots allocated by the constructor. */
+#define CHANNELCLIENT_REQUESTS 16
+
+/** Marks the end of the free request list. */
+#define CHANNELCLIENT_NO_REQUEST ((Size) ~0UL)
+
+/** VMShare tag of the shared memory holding a pair of Channels. */
+#define CHANNELCLIENT_SHARE_TAG 0
+
 /**
  * Client for using Channels.
+ *
+ * Outgoing requests are kept in a table indexed by their identifier.
+ * Inactive slots are linked in a free list, such that sending a request
+ * and matching its response both take constant time.
  */
 class ChannelClient : public Singleton<ChannelClient>
 {
@@ -51,6 +64,12 @@ class ChannelClient : public Singleton<ChannelClient>
         ChannelMessage *message;
         CallbackFunction *callback;
 
+        /** Size of the message buffer. */
+        Size size;
+
+        /** Next free slot, if inactive. */
+        Size nextFree;
+
         const bool operator == (const struct Request & req) const
         {
             return req.message == message && req.callback == callback;
@@ -118,13 +137,19 @@ class ChannelClient : public Singleton<ChannelClient>
      *
      * This function creates a producer and consumer Channel
      * to the given process and registers it with the ChannelRegistry.
+     * The shared mapping holds both channels, each consisting of its
+     * data area followed by a single feedback page.
      *
      * @param pid ProcessID for the process to connect to.
      * @param msgSize Default message size to use.
+     * @param ringSize Size of each channel data area in bytes,
+     *                 a multiple of PAGESIZE.
      *
      * @return Result code
      */
-    virtual Result connect(ProcessID pid, Size msgSize = sizeof(FileSystemMessage));
+    virtual Result connect(ProcessID pid,
+                           Size msgSize = sizeof(FileSystemMessage),
+                           Size ringSize = PAGESIZE);
 
     /**
      * Try to receive message from any channel.
@@ -214,13 +239,34 @@ class ChannelClient : public Singleton<ChannelClient>
      */
     Channel * findProducer(ProcessID pid);
 
+    /**
+     * Take a request slot from the free list.
+     *
+     * Allocates a new slot if the free list is empty.
+     *
+     * @param size Minimum size of the message buffer.
+     *
+     * @return Identifier of the slot or CHANNELCLIENT_NO_REQUEST on failure.
+     */
+    Size allocateRequest(Size size);
+
+    /**
+     * Return a request slot to the free list.
+     *
+     * @param identifier Identifier of the slot.
+     */
+    void releaseRequest(Size identifier);
+
   private:
 
     /** Contains registered channels */
     ChannelRegistry *m_registry;
 
-    /** Contains ongoing requests */
-    Index<Request> m_requests;
+    /** Request slots, indexed by identifier */
+    Vector<Request *> m_requests;
+
+    /** First free request slot */
+    Size m_freeRequest;
 };
 
 /**
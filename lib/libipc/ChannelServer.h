@@ -24,9 +24,13 @@
 #include <HashIterator.h>
 #include <Timer.h>
 #include "MemoryChannel.h"
+#include "Doorbell.h"
 #include "ChannelClient.h"
 #include "ChannelRegistry.h"
 
+/** Maximum number of messages to read from a Channel at once. */
+#define CHANNELSERVER_BATCH 8
+
 /**
  * @addtogroup lib
  * @{
@@ -120,6 +124,13 @@ template <class Base, class MsgType> class ChannelServer
             m_kernelEvent.setMessageSize(sizeof(ProcessEvent));
             m_kernelEvent.setVirtual(share.range.virt,
                                      share.range.virt + PAGESIZE);
+
+            // Doorbell pages follow the kernel event channel
+            if (share.range.size >= PAGESIZE * 4)
+            {
+                m_doorbell.setVirtual(share.range.virt + (PAGESIZE * 2),
+                                      share.range.virt + (PAGESIZE * 3));
+            }
         }
     }
 
@@ -227,6 +238,15 @@ template <class Base, class MsgType> class ChannelServer
         return false;
     }
 
+    /**
+     * Called when a process has terminated
+     *
+     * @param pid ProcessID of the terminated process
+     */
+    virtual void processTerminated(ProcessID pid)
+    {
+    }
+
     /**
      * Set a sleep timeout
      *
@@ -259,13 +279,16 @@ template <class Base, class MsgType> class ChannelServer
      */
     Result accept(ProcessID pid, Memory::Range range)
     {
+        // Each channel has its data area followed by a feedback page
+        Size ringSize = (range.size / 2) - PAGESIZE;
+
         // Create consumer
         if (!m_registry->getConsumer(pid))
         {
             MemoryChannel *consumer = new MemoryChannel;
             consumer->setMode(Channel::Consumer);
             consumer->setMessageSize(sizeof(MsgType));
-            consumer->setVirtual(range.virt, range.virt + PAGESIZE);
+            consumer->setVirtual(range.virt, range.virt + ringSize, ringSize);
             m_registry->registerConsumer(pid, consumer);
         }
         // Create producer
@@ -274,8 +297,9 @@ template <class Base, class MsgType> class ChannelServer
             MemoryChannel *producer = new MemoryChannel;
             producer->setMode(Channel::Producer);
             producer->setMessageSize(sizeof(MsgType));
-            producer->setVirtual(range.virt + (PAGESIZE*2),
-                                 range.virt + (PAGESIZE*3));
+            producer->setVirtual(range.virt + (range.size / 2),
+                                 range.virt + (range.size / 2) + ringSize,
+                                 ringSize);
             m_registry->registerProducer(pid, producer);
         }
         // Done
@@ -300,8 +324,12 @@ template <class Base, class MsgType> class ChannelServer
             {
                 case ShareCreated:
                 {
-                    DEBUG(m_self << ": share created for PID: " << event.share.pid);
-                    accept(event.share.pid, event.share.range);
+                    DEBUG(m_self << ": share created for PID: " << event.share.pid <<
+                          " tag: " << event.share.tagId);
+
+                    // Other tags are shares used by the server itself
+                    if (event.share.tagId == CHANNELCLIENT_SHARE_TAG)
+                        accept(event.share.pid, event.share.range);
                     break;
                 }
                 case InterruptEvent:
@@ -320,6 +348,9 @@ template <class Base, class MsgType> class ChannelServer
                     m_registry->unregisterConsumer(event.number);
                     m_registry->unregisterProducer(event.number);
 
+                    // allow the server to release per-process state
+                    m_instance->processTerminated(event.number);
+
                     // cleanup the VMShare area now for that process
                     VMShare(event.number, API::Delete, ZERO);
                     break;
@@ -333,25 +364,63 @@ template <class Base, class MsgType> class ChannelServer
     }
 
     /**
-     * Read each Channel for messages.
+     * Read each Channel with pending messages.
+     *
+     * Uses the Doorbell to find the channels written since
+     * the last call, or polls all channels if not available.
      *
      * @return Result code
      */
     Result readChannels()
     {
-        MsgType msg;
+        if (!m_doorbell.isEnabled())
+        {
+            for (HashIterator<ProcessID, Channel *> i(m_registry->getConsumers()); i.hasCurrent(); i++)
+                readChannel(i.key(), i.current());
 
-        // Try to receive message on each consumer channel
-        for (HashIterator<ProcessID, Channel *> i(m_registry->getConsumers()); i.hasCurrent(); i++)
+            return Success;
+        }
+
+        // Only visit the words and bits which changed
+        for (u32 words = m_doorbell.acknowledgeSummary(); words; words &= words - 1)
         {
-            Channel *ch = i.current();
-            DEBUG(m_self << ": trying to receive from PID " << i.key());
+            Size word = __builtin_ctz(words);
 
-            // Read all messages in the consumer channel
-            while (ch->read(&msg) == Channel::Success)
+            for (u32 bits = m_doorbell.acknowledge(word); bits; bits &= bits - 1)
             {
+                ProcessID pid = (word * 32) + __builtin_ctz(bits);
+                Channel *ch = m_registry->getConsumer(pid);
+
+                if (ch)
+                    readChannel(pid, ch);
+            }
+        }
+        return Success;
+    }
+
+    /**
+     * Read all messages from a Channel.
+     *
+     * @param pid ProcessID of the sender
+     * @param ch Consumer channel of the sender
+     */
+    void readChannel(ProcessID pid, Channel *ch)
+    {
+        MsgType batch[CHANNELSERVER_BATCH];
+        Size count;
+        bool resume = false;
+        DEBUG(m_self << ": trying to receive from PID " << pid);
+
+        // Read all messages in the consumer channel
+        for (count = CHANNELSERVER_BATCH;
+             ch->readMany(batch, &count) == Channel::Success;
+             count = CHANNELSERVER_BATCH)
+        {
+            for (Size j = 0; j < count; j++)
+            {
+                MsgType & msg = batch[j];
                 DEBUG(m_self << ": received message");
-                msg.from = i.key();
+                msg.from = pid;
 
                 // Is the message a response from earlier client request?
                 if (msg.type == ChannelMessage::Response)
@@ -371,22 +440,24 @@ template <class Base, class MsgType> class ChannelServer
                     // Send reply
                     if (m_sendReply)
                     {
-                        Channel *ch = m_registry->getProducer(i.key());
-                        if (!ch)
+                        Channel *prod = m_registry->getProducer(pid);
+                        if (!prod)
                         {
-                            ERROR(m_self << ": no producer channel found for PID: " << i.key());
+                            ERROR(m_self << ": no producer channel found for PID: " << pid);
                         }
-                        else if (ch->write(&msg) != Channel::Success)
+                        else if (prod->write(&msg) != Channel::Success)
                         {
-                            ERROR(m_self << ": failed to send reply message to PID: " << i.key());
+                            ERROR(m_self << ": failed to send reply message to PID: " << pid);
                         }
                         else
-                            ProcessCtl(i.key(), Resume, 0);
+                            resume = true;
                     }
                 }
             }
         }
-        return Success;
+        // Wakeup the client once for all replies
+        if (resume)
+            ProcessCtl(pid, Resume, 0);
     }
 
     /**
@@ -409,6 +480,9 @@ template <class Base, class MsgType> class ChannelServer
     /** Kernel event channel */
     MemoryChannel m_kernelEvent;
 
+    /** Channels with pending messages */
+    Doorbell m_doorbell;
+
     /** Should we send a reply message? */
     bool m_sendReply;
 
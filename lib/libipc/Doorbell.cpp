@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include "Doorbell.h"
+
+Doorbell::Doorbell()
+{
+}
+
+Doorbell::Result Doorbell::setVirtual(Address ring, Address ack)
+{
+    m_ring.setBase(ring);
+    m_ack.setBase(ack);
+    return Success;
+}
+
+bool Doorbell::isEnabled() const
+{
+    return m_ring.getBase() != 0;
+}
+
+Doorbell::Result Doorbell::ring(ProcessID pid)
+{
+    Size word = pid / 32;
+    u32 bit = 1 << (pid % 32);
+
+    if (!isEnabled() || word >= DOORBELL_WORDS)
+        return InvalidArgument;
+
+    Address offset = sizeof(u32) + (word * sizeof(u32));
+    u32 rung = m_ring.read(offset);
+
+    // Already pending?
+    if ((rung ^ m_ack.read(offset)) & bit)
+        return Success;
+
+    m_ring.write(offset, rung ^ bit);
+
+    // Mark the word as changed, unless still pending
+    u32 summary = m_ring.read(0);
+    if (!((summary ^ m_ack.read(0)) & (1 << word)))
+        m_ring.write(0, summary ^ (1 << word));
+
+    // The kernel writes the page via a separate mapping
+    if (isKernel)
+    {
+        Arch::Cache cache;
+        cache.cleanData(m_ring.getBase());
+    }
+    return Success;
+}
+
+u32 Doorbell::acknowledgeSummary()
+{
+    u32 rung = m_ring.read(0);
+    u32 pending = rung ^ m_ack.read(0);
+
+    m_ack.write(0, rung);
+    return pending;
+}
+
+u32 Doorbell::acknowledge(Size word)
+{
+    Address offset = sizeof(u32) + (word * sizeof(u32));
+    u32 rung = m_ring.read(offset);
+    u32 pending = rung ^ m_ack.read(offset);
+
+    m_ack.write(offset, rung);
+    return pending;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBIPC_DOORBELL_H
+#define __LIBIPC_DOORBELL_H
+
+#include <FreeNOS/System.h>
+#include <Types.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libipc
+ * @{
+ */
+
+/** Maximum number of processes which can ring a Doorbell. */
+#define DOORBELL_MAX_PROCS 1024
+
+/** Number of 32-bit words in the doorbell bitmap. */
+#define DOORBELL_WORDS (DOORBELL_MAX_PROCS / 32)
+
+/**
+ * Per-process bitmap of channels with pending messages.
+ *
+ * Uses two pages, each written by only one side. The ring page is
+ * written by the kernel when a process resumes the owner, the
+ * acknowledge page is written by the owner. A bit is pending when it
+ * differs between both pages. The summary word has one bit for each
+ * word of the bitmap, such that the owner only inspects words which
+ * changed. Neither side ever clears a bit written by the other side,
+ * so no atomic operations are needed.
+ */
+class Doorbell
+{
+  private:
+
+    /**
+     * In-memory layout of each page.
+     */
+    typedef struct Bitmap
+    {
+        /** One bit per changed word. */
+        u32 summary;
+
+        /** One bit per process. */
+        u32 words[DOORBELL_WORDS];
+    }
+    Bitmap;
+
+  public:
+
+    /**
+     * Result codes.
+     */
+    enum Result
+    {
+        Success,
+        InvalidArgument,
+        IOError
+    };
+
+    /**
+     * Constructor.
+     */
+    Doorbell();
+
+    /**
+     * Set memory pages by virtual address.
+     *
+     * @param ring Virtual address of the ring page.
+     *             Read/write for the kernel, read-only for the owner.
+     * @param ack Virtual address of the acknowledge page.
+     *            Read/write for the owner, read-only for the kernel.
+     *
+     * @return Result code.
+     */
+    Result setVirtual(Address ring, Address ack);
+
+    /**
+     * Check if the doorbell pages are set.
+     *
+     * @return True if set, false otherwise.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Ring the doorbell for a process.
+     *
+     * Does nothing if the bit for the process is still pending.
+     *
+     * @param pid ProcessID of the ringing process.
+     *
+     * @return Result code.
+     */
+    Result ring(ProcessID pid);
+
+    /**
+     * Acknowledge the summary word.
+     *
+     * @return Bitmask of words which have pending bits.
+     */
+    u32 acknowledgeSummary();
+
+    /**
+     * Acknowledge a single word of the bitmap.
+     *
+     * @param word Index of the word.
+     *
+     * @return Bitmask of pending processes in the word.
+     */
+    u32 acknowledge(Size word);
+
+  private:
+
+    /** Ring page */
+    Arch::IO m_ring;
+
+    /** Acknowledge page */
+    Arch::IO m_ack;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBIPC_DOORBELL_H */
@@ -23,6 +23,7 @@ MemoryChannel::MemoryChannel()
     : Channel()
 {
     MemoryBlock::set(&m_head, 0, sizeof(m_head));
+    m_ringSize = PAGESIZE;
 }
 
 MemoryChannel::~MemoryChannel()
@@ -31,75 +32,121 @@ MemoryChannel::~MemoryChannel()
 
 MemoryChannel::Result MemoryChannel::setMessageSize(Size size)
 {
-    if (size < sizeof(RingHead) || size > (PAGESIZE / 2))
+    if (size < sizeof(u32) || size > ((m_ringSize - CACHELINE_SIZE) / 2))
         return InvalidArgument;
 
     m_messageSize = size;
-    m_maximumMessages = (PAGESIZE / m_messageSize) - 1;
-
-    return Success;
+    return resize();
 }
 
-MemoryChannel::Result MemoryChannel::setVirtual(Address data, Address feedback)
+MemoryChannel::Result MemoryChannel::setVirtual(Address data, Address feedback, Size size)
 {
+    if (!size || (size % PAGESIZE))
+        return InvalidSize;
+
     m_data.setBase(data);
     m_feedback.setBase(feedback);
-    return Success;
+    m_ringSize = size;
+    return resize();
 }
 
-MemoryChannel::Result MemoryChannel::setPhysical(Address data, Address feedback)
+MemoryChannel::Result MemoryChannel::setPhysical(Address data, Address feedback, Size size)
 {
-    if (m_data.map(data, PAGESIZE) != IO::Success)
+    if (!size || (size % PAGESIZE))
+        return InvalidSize;
+
+    if (m_data.map(data, size) != IO::Success)
         return IOError;
 
     if (m_feedback.map(feedback, PAGESIZE) != IO::Success)
         return IOError;
 
-    return Success;
+    m_ringSize = size;
+    return resize();
 }
 
 MemoryChannel::Result MemoryChannel::read(void *buffer)
+{
+    Size count = 1;
+    return readMany(buffer, &count);
+}
+
+MemoryChannel::Result MemoryChannel::write(void *buffer)
+{
+    Size count = 1;
+    return writeMany(buffer, &count);
+}
+
+MemoryChannel::Result MemoryChannel::readMany(void *buffer, Size *count)
 {
     RingHead head;
+    u8 *buf = (u8 *) buffer;
+    Size num = 0;
 
     // Read the current ring head
     m_data.read(0, sizeof(head), &head);
 
+    // Read all available messages which fit in the buffer
+    while (num < *count && head.index != m_head.index)
+    {
+        m_data.read(slot(m_head.index), m_messageSize, buf + (num * m_messageSize));
+        m_head.index = (m_head.index + 1) % m_maximumMessages;
+        num++;
+    }
+    *count = num;
+
     // Check if a message is present
-    if (head.index == m_head.index)
+    if (!num)
         return NotFound;
 
-    // Read one message
-    m_data.read((m_head.index+1) * m_messageSize, m_messageSize, buffer);
-
-    // Increment head index
-    m_head.index = (m_head.index + 1) % m_maximumMessages;
-
     // Update read index
     m_feedback.write(0, sizeof(m_head), &m_head);
     return Success;
 }
 
-MemoryChannel::Result MemoryChannel::write(void *buffer)
+MemoryChannel::Result MemoryChannel::writeMany(void *buffer, Size *count)
 {
     RingHead reader;
+    u8 *buf = (u8 *) buffer;
+    Size num = 0;
 
     // Read current ring head
     m_feedback.read(0, sizeof(RingHead), &reader);
 
-    // Check if buffer space is available for the message
-    if (((m_head.index + 1) % m_maximumMessages) == reader.index)
-        return ChannelFull;
+    // Write messages while buffer space is available
+    while (num < *count && ((m_head.index + 1) % m_maximumMessages) != reader.index)
+    {
+        m_data.write(slot(m_head.index), m_messageSize, buf + (num * m_messageSize));
+        m_head.index = (m_head.index + 1) % m_maximumMessages;
+        num++;
+    }
+    *count = num;
 
-    // write the message
-    m_data.write((m_head.index+1) * m_messageSize, m_messageSize, buffer);
+    if (!num)
+        return ChannelFull;
 
-    // Increment write index
-    m_head.index = (m_head.index + 1) % m_maximumMessages;
+    // Publish the write index only after all messages are written
     m_data.write(0, sizeof(m_head), &m_head);
     return Success;
 }
 
+Size MemoryChannel::slot(Size index) const
+{
+    return CACHELINE_SIZE + (index * m_messageSize);
+}
+
+MemoryChannel::Result MemoryChannel::resize()
+{
+    if (!m_messageSize)
+        return Success;
+
+    if (m_messageSize > ((m_ringSize - CACHELINE_SIZE) / 2))
+        return InvalidSize;
+
+    m_maximumMessages = (m_ringSize - CACHELINE_SIZE) / m_messageSize;
+    return Success;
+}
+
 MemoryChannel::Result MemoryChannel::flush()
 {
     // Cannot flush caches in usermode. All usermode code
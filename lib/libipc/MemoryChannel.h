@@ -39,6 +39,16 @@
  * to the data page. The feedback page is written only by the
  * consumer, where it stores the feedback information from its
  * consumption, such as the total bytes read and status.
+ *
+ * The ring head occupies the first cache line of the data page and
+ * the message slots start at the next cache line. Messages are
+ * always stored before the ring head is published, such that
+ * producer and consumer may run on different cores.
+ *
+ * The data area may span multiple pages, which allows more messages
+ * to be in flight for bursty producers. All messages on a channel have
+ * the size given to setMessageSize(); records of variable length are
+ * not supported.
  */
 class MemoryChannel : public Channel
 {
@@ -76,10 +86,11 @@ class MemoryChannel : public Channel
      *             Read/Write for the producer, Read-only for the consumer.
      * @param feedback Virtual memory address of the feedback page.
      *        Read/write for the consumer, read-only for the producer.
+     * @param size Size of the data area in bytes, a multiple of PAGESIZE.
      *
      * @return Result code.
      */
-    Result setVirtual(Address data, Address feedback);
+    Result setVirtual(Address data, Address feedback, Size size = PAGESIZE);
 
     /**
      * Set memory pages by physical address.
@@ -91,10 +102,11 @@ class MemoryChannel : public Channel
      *             Read/Write for the producer, Read-only for the consumer.
      * @param feedback Physical memory address of the feedback page.
      *        Read/write for the consumer, read-only for the producer.
+     * @param size Size of the data area in bytes, a multiple of PAGESIZE.
      *
      * @return Result code.
      */
-    Result setPhysical(Address data, Address feedback);
+    Result setPhysical(Address data, Address feedback, Size size = PAGESIZE);
 
     /**
      * Set message size.
@@ -123,6 +135,34 @@ class MemoryChannel : public Channel
      */
     virtual Result write(void *buffer);
 
+    /**
+     * Read multiple messages.
+     *
+     * Reads the ring head once and publishes the new read
+     * index once for all messages read.
+     *
+     * @param buffer Output buffer for the messages.
+     * @param count On input the maximum number of messages to read,
+     *              on output the number of messages read.
+     *
+     * @return Result code.
+     */
+    virtual Result readMany(void *buffer, Size *count);
+
+    /**
+     * Write multiple messages.
+     *
+     * Reads the consumer index once and publishes the new
+     * ring head once for all messages written.
+     *
+     * @param buffer Input buffer with the messages.
+     * @param count On input the number of messages to write,
+     *              on output the number of messages written.
+     *
+     * @return Result code.
+     */
+    virtual Result writeMany(void *buffer, Size *count);
+
     /**
      * Flush message buffers.
      *
@@ -142,6 +182,24 @@ class MemoryChannel : public Channel
         return false;
     }
 
+  private:
+
+    /**
+     * Get the offset of a message slot in the data page.
+     *
+     * @param index Ring index of the message.
+     *
+     * @return Byte offset of the message slot.
+     */
+    Size slot(Size index) const;
+
+    /**
+     * Calculate the maximum number of messages in the ring.
+     *
+     * @return Result code.
+     */
+    Result resize();
+
   private:
 
     /** The data page */
@@ -152,6 +210,9 @@ class MemoryChannel : public Channel
 
     /** Local RingHead. */
     RingHead m_head;
+
+    /** Size of the data area in bytes. */
+    Size m_ringSize;
 };
 
 /**
@@ -31,8 +31,9 @@ int MPI_Recv(void *buf,
              MPI_Comm comm,
              MPI_Status *status)
 {
-    MPIMessage msg;
     MemoryChannel *ch;
+    u8 *data = (u8 *) buf;
+    Size num;
 
     if (datatype != MPI_INT)
         return MPI_ERR_UNSUPPORTED_DATAREP;
@@ -40,11 +41,16 @@ int MPI_Recv(void *buf,
     if (!(ch = (MemoryChannel *) readChannel->get(source)))
         return MPI_ERR_RANK;
 
-    for (int i = 0; i < count; i++)
+    // Read as many integers as available in the channel at once
+    for (Size left = count; left > 0; )
     {
-        while (ch->read(&msg) != Channel::Success)
-            ;
-        *(((int *) buf) + i) = msg.integer;
+        num = left;
+
+        if (ch->readMany(data, &num) == Channel::Success)
+        {
+            data += num * sizeof(MPIMessage);
+            left -= num;
+        }
     }
     return MPI_SUCCESS;
 }
@@ -30,8 +30,9 @@ int MPI_Send(const void *buf,
              int tag,
              MPI_Comm comm)
 {
-    MPIMessage msg;
     MemoryChannel *ch;
+    u8 *data = (u8 *) buf;
+    Size num;
 
     if (datatype != MPI_INT)
         return MPI_ERR_UNSUPPORTED_DATAREP;
@@ -39,12 +40,16 @@ int MPI_Send(const void *buf,
     if (!(ch = (MemoryChannel *) writeChannel->get(dest)))
         return MPI_ERR_RANK;
 
-    for (int i = 0; i < count; i++)
+    // Write as many integers as fit in the channel at once
+    for (Size left = count; left > 0; )
     {
-        msg.integer = *(((int *) buf) + i);
+        num = left;
 
-        while (ch->write(&msg) != Channel::Success)
-            ;
+        if (ch->writeMany(data, &num) == Channel::Success)
+        {
+            data += num * sizeof(MPIMessage);
+            left -= num;
+        }
     }
     return MPI_SUCCESS;
 }
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Checksum.h"
+
+/**
+ * Convert a single byte into a 16-bit word in host byte order,
+ * as if it were followed by a zero byte in memory.
+ */
+static inline u16 byteToWord(u8 byte)
+{
+    union
+    {
+        u16 word;
+        u8 bytes[2];
+    } w;
+
+    w.bytes[0] = byte;
+    w.bytes[1] = 0;
+    return w.word;
+}
+
+const u32 Checksum::fold(u64 sum)
+{
+    while (sum >> 16)
+        sum = (sum >> 16) + (sum & 0xffff);
+
+    return (u32) sum;
+}
+
+const u32 Checksum::add(const void *buffer, Size length, u32 sum)
+{
+    const u8 *ptr = (const u8 *) buffer;
+    bool swapped = false;
+    u64 acc = 0;
+
+    if (!length)
+        return sum;
+
+    // Sum an odd leading byte separately. The remaining words are then
+    // paired one byte off, which is corrected by swapping their sum afterwards.
+    if ((Address) ptr & 1)
+    {
+        acc += byteToWord(*ptr);
+        sum = fold((u64) sum + acc);
+        acc = 0;
+        ptr++;
+        length--;
+        swapped = true;
+    }
+
+    // Align to 32-bit words
+    if (((Address) ptr & 2) && length >= 2)
+    {
+        acc += *(const u16 *) ptr;
+        ptr += 2;
+        length -= 2;
+    }
+
+    // Sum 32-bit words, four at a time
+    const u32 *words = (const u32 *) ptr;
+
+    while (length >= 16)
+    {
+        acc += words[0];
+        acc += words[1];
+        acc += words[2];
+        acc += words[3];
+        words += 4;
+        length -= 16;
+    }
+
+    while (length >= 4)
+    {
+        acc += *words++;
+        length -= 4;
+    }
+
+    ptr = (const u8 *) words;
+
+    // Remaining 16-bit word and byte
+    if (length >= 2)
+    {
+        acc += *(const u16 *) ptr;
+        ptr += 2;
+        length -= 2;
+    }
+
+    if (length)
+        acc += byteToWord(*ptr);
+
+    // Fold the carries and restore the byte order, if needed
+    u32 result = fold(acc);
+
+    if (swapped)
+        result = ((result & 0xff) << 8) | (result >> 8);
+
+    return fold((u64) sum + result);
+}
+
+const u16 Checksum::finish(u32 sum)
+{
+    return (u16) ~fold(sum);
+}
+
+const u16 Checksum::calculate(const void *buffer, Size length)
+{
+    return finish(add(buffer, length));
+}
+
+const u16 Checksum::update(u16 checksum, u16 previous, u16 current)
+{
+    // HC' = ~(~HC + ~m + m')
+    u32 sum = (u16) ~checksum;
+    sum += (u16) ~previous;
+    sum += current;
+
+    return finish(sum);
+}
+
+const u16 Checksum::update(u16 checksum, u32 previous, u32 current)
+{
+    checksum = update(checksum, (u16) (previous >> 16), (u16) (current >> 16));
+    return update(checksum, (u16) (previous & 0xffff), (u16) (current & 0xffff));
+}
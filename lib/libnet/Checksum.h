@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBNET_CHECKSUM_H
+#define __LIBNET_CHECKSUM_H
+
+#include <Types.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libnet
+ * @{
+ */
+
+/**
+ * Internet checksum (RFC 1071) calculation.
+ *
+ * The checksum is the one's complement of the one's complement sum of all
+ * 16-bit words in the input. Because the one's complement sum is independent
+ * of byte order, all words are summed in host byte order and the result can
+ * be stored directly in the network header.
+ *
+ * Buffers are summed as 32-bit words into a 64-bit accumulator and the
+ * carries are only folded back once at the end.
+ */
+class Checksum
+{
+  public:
+
+    /**
+     * Add a buffer to a partial checksum.
+     *
+     * Can be called multiple times to sum discontiguous buffers,
+     * such as a pseudo header and payload. All buffers except
+     * the last must have an even length.
+     *
+     * @param buffer Input buffer
+     * @param length Number of bytes in the buffer
+     * @param sum Partial sum to add to
+     *
+     * @return Partial sum, folded to 16 bits
+     */
+    static const u32 add(const void *buffer, Size length, u32 sum = 0);
+
+    /**
+     * Convert a partial sum into a checksum.
+     *
+     * @param sum Partial sum returned by add()
+     *
+     * @return Checksum value
+     */
+    static const u16 finish(u32 sum);
+
+    /**
+     * Calculate the checksum of a buffer.
+     *
+     * @param buffer Input buffer
+     * @param length Number of bytes in the buffer
+     *
+     * @return Checksum value
+     */
+    static const u16 calculate(const void *buffer, Size length);
+
+    /**
+     * Update a checksum after modifying a 16-bit field (RFC 1624).
+     *
+     * @param checksum Current checksum value
+     * @param previous Previous value of the field, as stored in the buffer
+     * @param current New value of the field, as stored in the buffer
+     *
+     * @return Updated checksum value
+     */
+    static const u16 update(u16 checksum, u16 previous, u16 current);
+
+    /**
+     * Update a checksum after modifying a 32-bit field (RFC 1624).
+     *
+     * @param checksum Current checksum value
+     * @param previous Previous value of the field, as stored in the buffer
+     * @param current New value of the field, as stored in the buffer
+     *
+     * @return Updated checksum value
+     */
+    static const u16 update(u16 checksum, u32 previous, u32 current);
+
+  private:
+
+    /**
+     * Fold a sum into 16 bits.
+     *
+     * @param sum Input sum
+     *
+     * @return Sum with all carries added back
+     */
+    static const u32 fold(u64 sum);
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBNET_CHECKSUM_H */
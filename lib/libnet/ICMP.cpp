@@ -21,6 +21,7 @@
 #include "ICMPFactory.h"
 #include "ICMPSocket.h"
 #include "IPV4.h"
+#include "Checksum.h"
 
 ICMP::ICMP(NetworkServer *server,
            NetworkDevice *device)
@@ -125,5 +126,5 @@ Error ICMP::sendPacket(IPV4::Address ip, ICMP::Header *header)
 
 const u16 ICMP::checksum(Header *header)
 {
-    return IPV4::checksum(header, sizeof(*header));
+    return Checksum::calculate(header, sizeof(*header));
 }
@@ -25,6 +25,7 @@
 #include "IPV4Address.h"
 #include "UDP.h"
 #include "ICMP.h"
+#include "Checksum.h"
 
 IPV4::IPV4(NetworkServer *server,
            NetworkDevice *device)
@@ -155,27 +156,7 @@ Error IPV4::getTransmitPacket(NetworkQueue::Packet **pkt,
 
 const u16 IPV4::checksum(const void *buffer, Size len)
 {
-    const u16 *ptr = (const u16 *) buffer;
-    uint sum = 0;
-
-    // Calculate sum of the buffer
-    while (len > 1)
-    {
-        sum += *ptr;
-        ptr++;
-        len -= 2;
-    }
-
-    // Add left-over byte, if any
-    if (len > 0)
-        sum += be16_to_cpu(*((u8 *)ptr) << 8);
-
-    // Enforce 16-bit checksum
-    while (sum >> 16)
-        sum = (sum >> 16) + (sum & 0xFFFF);
-
-    // Convert to one's complement
-    return (~sum);
+    return Checksum::calculate(buffer, len);
 }
 
 Error IPV4::process(NetworkQueue::Packet *pkt, Size offset)
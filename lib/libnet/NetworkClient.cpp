@@ -20,6 +20,7 @@
 #include <Log.h>
 #include <String.h>
 #include <Runtime.h>
+#include <ChannelClient.h>
 #include "NetworkClient.h"
 #include "ARP.h"
 #include "ARPSocket.h"
@@ -69,6 +70,11 @@ NetworkClient::Result NetworkClient::initialize()
         return IOError;
     }
     m_deviceName = match->path;
+
+    // Use larger rings for the bursty traffic to the network server
+    if (!ChannelClient::instance->getRegistry()->getProducer(match->procID))
+        ChannelClient::instance->connect(match->procID, sizeof(FileSystemMessage), PAGESIZE * 4);
+
     return Success;
 }
 
@@ -100,23 +106,26 @@ NetworkClient::Result NetworkClient::createSocket(NetworkClient::SocketType type
         return IOError;
 }
 
-NetworkClient::Result NetworkClient::connectSocket(int sock, IPV4::Address addr, u16 port)
+NetworkClient::Result NetworkClient::connectSocket(int sock, IPV4::Address addr, u16 port,
+                                                   NetworkClient::SocketMode mode)
 {
     DEBUG("");
-    return writeSocketInfo(sock, addr, port, Connect);
+    return writeSocketInfo(sock, addr, port, Connect, mode);
 }
 
-NetworkClient::Result NetworkClient::bindSocket(int sock, IPV4::Address addr, u16 port)
+NetworkClient::Result NetworkClient::bindSocket(int sock, IPV4::Address addr, u16 port,
+                                                NetworkClient::SocketMode mode)
 {
     DEBUG("");
-    return writeSocketInfo(sock, addr, port, Listen);
+    return writeSocketInfo(sock, addr, port, Listen, mode);
 }
 
 NetworkClient::Result NetworkClient::writeSocketInfo(
     int sock,
     IPV4::Address addr,
     u16 port,
-    NetworkClient::SocketAction action)
+    NetworkClient::SocketAction action,
+    NetworkClient::SocketMode mode)
 {
     char buf[64];
 
@@ -137,6 +146,7 @@ NetworkClient::Result NetworkClient::writeSocketInfo(
     info.address = addr;
     info.port    = port;
     info.action  = action;
+    info.mode    = mode;
 
     r = ::write(sock, &info, sizeof(info));
     if (r < 0)
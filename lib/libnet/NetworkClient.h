@@ -54,6 +54,18 @@ class NetworkClient
         Listen
     };
 
+    /**
+     * Socket I/O modes
+     */
+    enum SocketMode
+    {
+        /** One datagram per read/write, prefixed with a SocketInfo */
+        Single,
+
+        /** Multiple datagrams per read/write, each prefixed with a DatagramHeader */
+        Batched
+    };
+
     /**
      * Socket information
      *
@@ -65,9 +77,25 @@ class NetworkClient
         IPV4::Address address;
         u16 port;
         SocketAction action;
+        SocketMode mode;
     }
     SocketInfo;
 
+    /**
+     * Datagram header for batched socket I/O.
+     *
+     * In Batched mode the data read from or written to a socket
+     * is a sequence of datagrams, each consisting of this header
+     * directly followed by the payload of the given size.
+     */
+    typedef struct DatagramHeader
+    {
+        IPV4::Address address;
+        u16 port;
+        u16 size;
+    }
+    DatagramHeader;
+
     /**
      * Socket types
      */
@@ -126,10 +154,12 @@ class NetworkClient
      * @param sock Socket index
      * @param addr Address of the host to connect to
      * @param port Port of the host to connect to (or ZERO to ignore)
+     * @param mode I/O mode for reading and writing the socket
      *
      * @return Result code
      */
-    Result connectSocket(int sock, IPV4::Address addr, u16 port = 0);
+    Result connectSocket(int sock, IPV4::Address addr, u16 port = 0,
+                         SocketMode mode = Single);
 
     /**
      * Bind socket to address/port.
@@ -137,10 +167,12 @@ class NetworkClient
      * @param sock Socket index
      * @param addr Address of the address to bind to
      * @param port Port to bind to
+     * @param mode I/O mode for reading and writing the socket
      *
      * @return Result code
      */
-    Result bindSocket(int sock, IPV4::Address addr = 0, u16 port = 0);
+    Result bindSocket(int sock, IPV4::Address addr = 0, u16 port = 0,
+                      SocketMode mode = Single);
 
     /**
      * Close the socket.
@@ -157,7 +189,8 @@ class NetworkClient
      * Set socket to new state.
      */
     Result writeSocketInfo(int sock, IPV4::Address addr,
-                           u16 port, SocketAction action);
+                           u16 port, SocketAction action,
+                           SocketMode mode);
 
   private:
 
@@ -19,8 +19,8 @@
 
 NetworkDevice::NetworkDevice(NetworkServer *server)
     : Device(CharacterDeviceFile),
-      m_receive(1500),
-      m_transmit(1500)
+      m_receive(1500, 0, 64),
+      m_transmit(1500, 0, 64)
 {
     m_maximumPacketSize = 1500;
     m_server = server;
@@ -19,29 +19,41 @@
 
 NetworkQueue::NetworkQueue(Size packetSize, Size headerSize, Size queueSize)
 {
+    Size slots = 1;
+
+    // Round the number of slots up to a power of two
+    while (slots < queueSize)
+        slots <<= 1;
+
     m_packetSize   = packetSize;
     m_packetHeader = headerSize;
+    m_mask         = slots - 1;
+    m_packets      = new Packet[slots];
+    m_buffer       = new u8[slots * packetSize];
+    m_free         = new Packet *[slots];
+    m_data         = new Packet *[slots];
+    m_freeHead     = slots;
+    m_freeTail     = 0;
+    m_dataHead     = 0;
+    m_dataTail     = 0;
 
-    for (Size i = 0; i < queueSize; i++)
+    // Initially all packets are unused
+    for (Size i = 0; i < slots; i++)
     {
-        Packet *packet = new Packet;
-        packet->size = m_packetHeader;
-        packet->data = new u8[packetSize];
-        m_free.insert(*packet);
+        m_packets[i].size = m_packetHeader;
+        m_packets[i].data = m_buffer + (i * packetSize);
+        m_packets[i].refCount = 0;
+        m_packets[i].queue = this;
+        m_free[i] = &m_packets[i];
     }
 }
 
 NetworkQueue::~NetworkQueue()
 {
-    for (Size i = 0; i < m_free.size(); i++)
-    {
-        Packet *p = (Packet *) m_free.get(i);
-        if (p)
-        {
-            delete p->data;
-            delete p;
-        }
-    }
+    delete[] m_data;
+    delete[] m_free;
+    delete[] m_buffer;
+    delete[] m_packets;
 }
 
 void NetworkQueue::setHeaderSize(Size size)
@@ -49,42 +61,64 @@ void NetworkQueue::setHeaderSize(Size size)
     m_packetHeader = size;
 }
 
+Size NetworkQueue::size() const
+{
+    return m_mask + 1;
+}
+
+Size NetworkQueue::count() const
+{
+    return m_dataHead - m_dataTail;
+}
+
+Size NetworkQueue::available() const
+{
+    return m_freeHead - m_freeTail;
+}
+
 NetworkQueue::Packet * NetworkQueue::get()
 {
-    for (Size i = 0; i < m_free.size(); i++)
-    {
-        Packet *p = (Packet *) m_free.get(i);
-        if (p)
-        {
-            p->size = m_packetHeader;
-            m_free.remove(i);
-            return p;
-        }
-    }
-    return ZERO;
+    if (m_freeHead == m_freeTail)
+        return ZERO;
+
+    Packet *p = m_free[m_freeTail & m_mask];
+    m_freeTail++;
+    p->size = m_packetHeader;
+    p->refCount = 1;
+    return p;
+}
+
+void NetworkQueue::retain(NetworkQueue::Packet *packet)
+{
+    packet->refCount++;
 }
 
 void NetworkQueue::release(NetworkQueue::Packet *packet)
 {
+    if (packet->refCount > 1)
+    {
+        packet->refCount--;
+        return;
+    }
+
+    packet->refCount = 0;
     packet->size = m_packetHeader;
-    m_free.insert(*packet);
+    m_free[m_freeHead & m_mask] = packet;
+    m_freeHead++;
 }
 
 void NetworkQueue::push(NetworkQueue::Packet *packet)
 {
-    m_data.insert(*packet);
+    m_data[m_dataHead & m_mask] = packet;
+    m_dataHead++;
 }
 
 NetworkQueue::Packet * NetworkQueue::pop()
 {
-    for (Size i = 0; i < m_data.size(); i++)
-    {
-        Packet *p = (Packet *) m_data.get(i);
-        if (p)
-        {
-            m_data.remove(i);
-            return p;
-        }
-    }
-    return ZERO;
+    if (m_dataHead == m_dataTail)
+        return ZERO;
+
+    Packet *p = m_data[m_dataTail & m_mask];
+    m_dataTail++;
+    return p;
 }
@@ -19,7 +19,7 @@
 #define __LIBNET_NETWORKQUEUE_H
 
 #include <Types.h>
-#include <Index.h>
+#include <Macros.h>
 
 /**
  * @addtogroup lib
@@ -31,6 +31,19 @@
 
 /**
  * Networking packet queue implementation.
+ *
+ * Packets are reference counted. Protocol handlers may hold on to a
+ * received packet with retain() instead of copying it, and the packet
+ * returns to the queue it was allocated from once the last reference
+ * is dropped with release().
+ *
+ * All packets and their payload are allocated up front in a single
+ * contiguous arena. Unused and pending packets are kept in two ring buffers
+ * with a power of two number of slots, such that packets are delivered in
+ * First-In-First-Out (FIFO) order and every operation is O(1).
+ *
+ * Each ring has a single producer and a single consumer: the head index
+ * is only written by push/release and the tail index only by pop/get.
  */
 class NetworkQueue
 {
@@ -44,6 +57,12 @@ class NetworkQueue
         Size size;
         u8 *data;
 
+        /** Number of references held to the packet */
+        Size refCount;
+
+        /** Queue which owns the packet */
+        NetworkQueue *queue;
+
         const bool operator == (const struct Packet & pkt) const
         {
             return pkt.size == size && pkt.data == data;
@@ -62,7 +81,8 @@ class NetworkQueue
      *
      * @param packetSize The size of each packet in bytes
      * @param headerSize Size of the physical header, if any
-     * @param queueSize The size of the queue in number of packets
+     * @param queueSize The size of the queue in number of packets.
+     *                  Rounded up to the next power of two.
      */
     NetworkQueue(Size packetSize, Size headerSize = 0, Size queueSize = 8);
 
@@ -76,13 +96,47 @@ class NetworkQueue
      */
     void setHeaderSize(Size size);
 
+    /**
+     * Get the maximum number of packets in the queue.
+     *
+     * @return Number of packets
+     */
+    Size size() const;
+
+    /**
+     * Get the number of packets with data.
+     *
+     * @return Number of pending packets
+     */
+    Size count() const;
+
+    /**
+     * Get the number of unused packets.
+     *
+     * @return Number of packets available via get()
+     */
+    Size available() const;
+
     /**
      * Get unused packet
+     *
+     * @return Packet pointer or ZERO if all packets are in use
      */
     Packet * get();
 
     /**
-     * Put unused packet back.
+     * Add a reference to a packet.
+     *
+     * @param packet Packet previously returned by get()
+     */
+    void retain(Packet *packet);
+
+    /**
+     * Drop a reference to a packet.
+     *
+     * The packet is put back as unused when the last reference is dropped.
+     *
+     * @param packet Packet previously returned by get()
      */
     void release(Packet *packet);
 
@@ -93,16 +147,33 @@ class NetworkQueue
 
     /**
      * Retrieve packet with data.
+     *
+     * @return Oldest pushed packet or ZERO if none available
      */
     Packet * pop();
 
   private:
 
-    /** Contains unused packets */
-    Index<Packet> m_free;
+    /** Packet descriptors arena */
+    Packet *m_packets;
+
+    /** Packet payload arena */
+    u8 *m_buffer;
+
+    /** Ring of unused packets */
+    Packet **m_free;
+
+    /** Ring of packets with data */
+    Packet **m_data;
+
+    /** Number of slots in each ring minus one */
+    Size m_mask;
+
+    /** Free ring producer and consumer indices */
+    Size m_freeHead, m_freeTail;
 
-    /** Contains packets with data */
-    Index<Packet> m_data;
+    /** Data ring producer and consumer indices */
+    Size m_dataHead, m_dataTail;
 
     /** Size of each packet */
     Size m_packetSize;
@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <MemoryBlock.h>
 #include "NetworkSocket.h"
 
 NetworkSocket::NetworkSocket(Size packetSize)
@@ -22,6 +23,7 @@ NetworkSocket::NetworkSocket(Size packetSize)
       m_transmit(packetSize)
 {
     m_pid = 0;
+    MemoryBlock::set(&m_info, 0, sizeof(m_info));
 }
 
 NetworkSocket::~NetworkSocket()
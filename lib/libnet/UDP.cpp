@@ -20,6 +20,7 @@
 #include "UDP.h"
 #include "UDPSocket.h"
 #include "UDPFactory.h"
+#include "Checksum.h"
 
 UDP::UDP(NetworkServer *server,
          NetworkDevice *device)
@@ -70,10 +71,19 @@ UDPSocket * UDP::createSocket(String & path)
 
 Error UDP::process(NetworkQueue::Packet *pkt, Size offset)
 {
-    Header *hdr = (Header *)(pkt->data + sizeof(Ethernet::Header) + sizeof(IPV4::Header));
+    Header *hdr = (Header *)(pkt->data + offset);
     u16 port = be16_to_cpu(hdr->destPort);
+    Size length = be16_to_cpu(hdr->length);
 
-    DEBUG("port = " << port);
+    DEBUG("port = " << port << " length = " << length);
+
+    // The datagram must fit inside the received packet
+    if (offset + sizeof(Header) > pkt->size ||
+        length < sizeof(Header) || length > pkt->size - offset)
+    {
+        DEBUG("dropped: invalid length");
+        return EINVAL;
+    }
 
     // Process the packet if we have a socket on that port
     UDPSocket **sock = (UDPSocket **) m_ports.get(port);
@@ -82,26 +92,24 @@ Error UDP::process(NetworkQueue::Packet *pkt, Size offset)
         DEBUG("dropped");
         return EINVAL;
     }
-    (*sock)->process(pkt);
-    return ESUCCESS;
+    return (*sock)->process(pkt, offset);
 }
 
-Error UDP::sendPacket(NetworkClient::SocketInfo *src, IOBuffer & buffer, Size size)
+Error UDP::sendPacket(const NetworkClient::SocketInfo *src,
+                      const NetworkClient::SocketInfo *dest,
+                      IOBuffer & buffer,
+                      Size size,
+                      Size offset)
 {
-    NetworkClient::SocketInfo dest;
     NetworkQueue::Packet *pkt;
     Header *hdr;
     Error r;
 
-    DEBUG("");
-
-    // Read destination
-    buffer.read(&dest, sizeof(dest));
-    DEBUG("send payload to: " << dest.address << " port: " << dest.port << " size: " << size);
+    DEBUG("send payload to: " << dest->address << " port: " << dest->port << " size: " << size);
 
     // Get a fresh IP packet
     r = m_ipv4->getTransmitPacket(
-        &pkt, dest.address, IPV4::UDP, sizeof(Header) + size - sizeof(dest)
+        &pkt, dest->address, IPV4::UDP, sizeof(Header) + size
     );
     if (r != ESUCCESS)
         return r;
@@ -109,20 +117,20 @@ Error UDP::sendPacket(NetworkClient::SocketInfo *src, IOBuffer & buffer, Size si
     // Fill UDP header
     hdr = (Header *) (pkt->data + pkt->size);
     hdr->sourcePort = cpu_to_be16(src->port);
-    hdr->destPort   = cpu_to_be16(dest.port);
-    hdr->length     = cpu_to_be16(size - sizeof(dest) + sizeof(Header));
+    hdr->destPort   = cpu_to_be16(dest->port);
+    hdr->length     = cpu_to_be16(size + sizeof(Header));
     hdr->checksum   = 0;
 
-    // Insert payload. The payload is just after the 'dest' struct in the IOBuffer.
-    buffer.read(pkt->data + pkt->size + sizeof(Header), size - sizeof(dest), sizeof(dest));
+    // Insert payload
+    buffer.read(pkt->data + pkt->size + sizeof(Header), size, offset);
 
     // Calculate final checksum
     hdr->checksum = checksum((IPV4::Header *)(pkt->data + pkt->size - sizeof(IPV4::Header)),
-                             hdr, size - sizeof(dest));
+                             hdr, size);
     DEBUG("checksum = " << (uint) hdr->checksum);
 
     // Increment packet size
-    pkt->size += sizeof(Header) + size - sizeof(dest);
+    pkt->size += sizeof(Header) + size;
 
     // Transmit now
     return m_device->transmit(pkt);
@@ -139,28 +147,12 @@ Error UDP::bind(UDPSocket *sock, u16 port)
     return ESUCCESS;
 }
 
-const ulong UDP::calculateSum(const u16 *ptr, Size bytes)
-{
-    ulong sum = 0;
-
-    for (;bytes > 0; bytes -= 2, ptr++)
-    {
-        if (bytes == 1) {
-            sum += *(u8 *)ptr;
-            break;
-        }
-        else
-            sum += *ptr;
-    }
-    return sum;
-}
-
 const u16 UDP::checksum(const IPV4::Header *ip,
                         const UDP::Header *udp,
                         const Size datalen)
 {
     IPV4::PseudoHeader phr;
-    ulong sum = 0;
+    u32 sum;
 
     // Setup a pseudo header
     phr.reserved    = 0;
@@ -170,15 +162,8 @@ const u16 UDP::checksum(const IPV4::Header *ip,
     phr.length      = cpu_to_be16((sizeof(Header) + datalen));
     DEBUG("ip src = " << phr.source << " dst = " << phr.destination);
 
-    // Sum the pseudo header
-    sum += calculateSum((u16 *) &phr, sizeof(phr));
-    sum += calculateSum((u16 *) udp, sizeof(*udp) + datalen);
-
-    // Keep only last 16 bits and add carry bits
-    sum = (sum >> 16) + (sum & 0xffff);
-    sum += (sum >> 16);
-
-    // Take one's complement
-    sum = ~sum;
-    return (u16) sum;
+    // Sum the pseudo header, UDP header and payload
+    sum = Checksum::add(&phr, sizeof(phr));
+    sum = Checksum::add(udp, sizeof(*udp) + datalen, sum);
+    return Checksum::finish(sum);
 }
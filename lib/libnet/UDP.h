@@ -104,8 +104,20 @@ class UDP : public NetworkProtocol
 
     /**
      * Send packet
+     *
+     * @param src Source socket information
+     * @param dest Destination socket information
+     * @param buffer Input buffer containing the payload
+     * @param size Size of the payload in bytes
+     * @param offset Offset of the payload inside the buffer
+     *
+     * @return Error code
      */
-    Error sendPacket(NetworkClient::SocketInfo *info, IOBuffer & buffer, Size size);
+    Error sendPacket(const NetworkClient::SocketInfo *src,
+                     const NetworkClient::SocketInfo *dest,
+                     IOBuffer & buffer,
+                     Size size,
+                     Size offset);
 
     /**
      * Calculate ICMP checksum
@@ -117,11 +129,6 @@ class UDP : public NetworkProtocol
                               const Header *header,
                               const Size datalen);
 
-  private:
-
-    static const ulong calculateSum(const u16 *ptr,
-                                    Size bytes);
-
   private:
 
     UDPFactory *m_factory;
@@ -16,13 +16,14 @@
  */
 
 #include <stdlib.h>
+#include <MemoryBlock.h>
 #include "Ethernet.h"
 #include "UDP.h"
 #include "UDPSocket.h"
 
 UDPSocket::UDPSocket(UDP *udp)
-    : NetworkSocket(udp->getMaximumPacketSize()),
-      m_queue(udp->getMaximumPacketSize())
+    : NetworkSocket(udp->getMaximumPacketSize())
+    , m_copies(udp->getMaximumPacketSize())
 {
     m_udp  = udp;
     m_port = 0;
@@ -30,6 +31,11 @@ UDPSocket::UDPSocket(UDP *udp)
 
 UDPSocket::~UDPSocket()
 {
+    while (m_queue.count())
+    {
+        NetworkQueue::Packet *pkt = m_queue.pop().packet;
+        pkt->queue->release(pkt);
+    }
 }
 
 const u16 UDPSocket::getPort() const
@@ -39,29 +45,72 @@ const u16 UDPSocket::getPort() const
 
 Error UDPSocket::read(IOBuffer & buffer, Size size, Size offset)
 {
+    const bool batched = m_info.mode == NetworkClient::Batched;
+    const Size headerSize = batched ? sizeof(NetworkClient::DatagramHeader) :
+                                      sizeof(NetworkClient::SocketInfo);
+    Size total = 0;
+
     DEBUG("");
 
-    NetworkQueue::Packet *pkt = m_queue.pop();
-    if (!pkt)
+    if (!m_queue.count())
         return EAGAIN;
 
-    IPV4::Header *ipHdr = (IPV4::Header *)(pkt->data + sizeof(Ethernet::Header));
-    UDP::Header *udpHdr = (UDP::Header *)(pkt->data + sizeof(Ethernet::Header) + sizeof(IPV4::Header));
-    NetworkClient::SocketInfo info;
-    Size payloadSize = pkt->size - sizeof(Ethernet::Header)
-                                 - sizeof(IPV4::Header)
-                                 - sizeof(UDP::Header);
-
-    // Fill socket info
-    info.address = ipHdr->source;
-    info.port    = udpHdr->sourcePort;
-    buffer.write(&info, sizeof(info));
-
-    // Fill payload
-    Size sz = size > payloadSize ? payloadSize : size;
-    buffer.write(udpHdr+1, sz, sizeof(info));
-    m_queue.release(pkt);
-    return sz + sizeof(info);
+    if (size < headerSize)
+        return EINVAL;
+
+    // In Batched mode, return as many datagrams as fit in the buffer
+    do
+    {
+        const Datagram & dgram = m_queue.peek();
+        NetworkQueue::Packet *pkt = dgram.packet;
+        IPV4::Header *ipHdr = (IPV4::Header *)(pkt->data + dgram.offset - sizeof(IPV4::Header));
+        UDP::Header *udpHdr = (UDP::Header *)(pkt->data + dgram.offset);
+        Size payloadSize = be16_to_cpu(udpHdr->length);
+
+        // Never read beyond the received packet
+        if (payloadSize > pkt->size - dgram.offset)
+            payloadSize = pkt->size - dgram.offset;
+
+        // Payload size without the UDP header
+        payloadSize = payloadSize > sizeof(UDP::Header) ?
+                      payloadSize - sizeof(UDP::Header) : 0;
+
+        // Only the first datagram may be truncated
+        if (total && total + headerSize + payloadSize > size)
+            break;
+
+        Size sz = size - total - headerSize;
+        if (sz > payloadSize)
+            sz = payloadSize;
+
+        // Fill datagram header
+        if (batched)
+        {
+            NetworkClient::DatagramHeader header;
+            header.address = ipHdr->source;
+            header.port    = udpHdr->sourcePort;
+            header.size    = sz;
+            buffer.write(&header, sizeof(header), total);
+        }
+        else
+        {
+            NetworkClient::SocketInfo info;
+            info.address = ipHdr->source;
+            info.port    = udpHdr->sourcePort;
+            buffer.write(&info, sizeof(info), total);
+        }
+
+        // Fill payload
+        buffer.write(udpHdr+1, sz, total + headerSize);
+        total += headerSize + sz;
+
+        // Drop our reference to the packet buffer
+        m_queue.pop();
+        pkt->queue->release(pkt);
+    }
+    while (batched && m_queue.count());
+
+    return total;
 }
 
 Error UDPSocket::write(IOBuffer & buffer, Size size, Size offset)
@@ -84,23 +133,88 @@ Error UDPSocket::write(IOBuffer & buffer, Size size, Size offset)
         else
             return size;
     }
+    else if (m_info.mode == NetworkClient::Batched)
+        return writeBatched(buffer, size);
     else
-        return m_udp->sendPacket(&m_info, buffer, size);
+    {
+        NetworkClient::SocketInfo dest;
+
+        // The payload follows the destination
+        buffer.read(&dest, sizeof(dest));
+        return m_udp->sendPacket(&m_info, &dest, buffer,
+                                 size - sizeof(dest), sizeof(dest));
+    }
+}
+
+Error UDPSocket::writeBatched(IOBuffer & buffer, Size size)
+{
+    NetworkClient::DatagramHeader header;
+    NetworkClient::SocketInfo dest;
+    Size total = 0;
+    Error r = EINVAL;
+
+    // Send each datagram in the buffer
+    while (total + sizeof(header) <= size)
+    {
+        buffer.read(&header, sizeof(header), total);
+
+        if (total + sizeof(header) + header.size > size)
+        {
+            r = EINVAL;
+            break;
+        }
+
+        dest.address = header.address;
+        dest.port    = header.port;
+
+        r = m_udp->sendPacket(&m_info, &dest, buffer, header.size, total + sizeof(header));
+        if (r < 0)
+            break;
+
+        total += sizeof(header) + header.size;
+    }
+
+    // Report the datagrams sent so far, if any
+    return total ? (Error) total : r;
 }
 
 Error UDPSocket::process(NetworkQueue::Packet *pkt)
 {
+    return process(pkt, sizeof(Ethernet::Header) + sizeof(IPV4::Header));
+}
+
+Error UDPSocket::process(NetworkQueue::Packet *pkt, Size offset)
+{
+    Datagram dgram;
+
     DEBUG("");
 
-    NetworkQueue::Packet *buf = m_queue.get();
-    if (!buf)
+    if (m_queue.count() == UDPSOCKET_QUEUE_SIZE)
     {
         ERROR("udp socket queue full");
         return EIO;
     }
-    buf->size = pkt->size;
-    MemoryBlock::copy(buf->data, pkt->data, pkt->size);
-    m_queue.push(buf);
+    dgram.offset = offset;
+
+    // Keep a reference to the packet until it is read, unless
+    // the device is running low on packets
+    if (pkt->queue->available() >= pkt->queue->size() / UDPSOCKET_RESERVE_DIVISOR)
+    {
+        dgram.packet = pkt;
+        pkt->queue->retain(pkt);
+    }
+    else
+    {
+        if (pkt->size > m_udp->getMaximumPacketSize() ||
+            !(dgram.packet = m_copies.get()))
+        {
+            ERROR("udp socket copy buffers full");
+            return EIO;
+        }
+        MemoryBlock::copy(dgram.packet->data, pkt->data, pkt->size);
+        dgram.packet->size = pkt->size;
+    }
+    m_queue.push(dgram);
     return ESUCCESS;
 }
 
@@ -18,6 +18,7 @@
 #ifndef __LIBNET_UDPSOCKET_H
 #define __LIBNET_UDPSOCKET_H
 
+#include <Queue.h>
 #include "NetworkSocket.h"
 #include "NetworkQueue.h"
 #include "NetworkClient.h"
@@ -32,14 +33,45 @@ class UDP;
  * @{
  */
 
+/** Maximum number of received datagrams pending on a UDPSocket */
+#define UDPSOCKET_QUEUE_SIZE 16
+
+/** Copy datagrams when less than this fraction of the device packets is unused */
+#define UDPSOCKET_RESERVE_DIVISOR 4
+
 /**
  * User Datagram Protocol (UDP) socket.
  *
  * UDP sockets accept payloads to send when writing
  * and read payloads when receiving payloads.
+ *
+ * Received packets are normally not copied: the socket keeps a reference
+ * to the packet buffer of the device until the payload is read. When the
+ * device runs low on unused packets, datagrams are copied into packets
+ * owned by the socket instead, such that idle sockets cannot starve
+ * the device.
+ *
+ * A socket bound or connected in NetworkClient::Batched mode transfers
+ * multiple datagrams per read and write, each prefixed with a
+ * NetworkClient::DatagramHeader, to avoid an IPC round trip per packet.
  */
 class UDPSocket : public NetworkSocket
 {
+  private:
+
+    /**
+     * Received datagram pending for reading.
+     */
+    typedef struct Datagram
+    {
+        /** Packet containing the datagram */
+        NetworkQueue::Packet *packet;
+
+        /** Offset of the UDP header inside the packet */
+        Size offset;
+    }
+    Datagram;
+
   public:
 
     /**
@@ -88,6 +120,16 @@ class UDPSocket : public NetworkSocket
      */
     virtual Error process(NetworkQueue::Packet *pkt);
 
+    /**
+     * Process incoming network packet.
+     *
+     * @param pkt Packet with the UDP datagram
+     * @param offset Offset of the UDP header inside the packet
+     *
+     * @return Error code
+     */
+    Error process(NetworkQueue::Packet *pkt, Size offset);
+
     /**
      * Set error status
      *
@@ -104,6 +146,18 @@ class UDPSocket : public NetworkSocket
         return false;
     }
 
+  private:
+
+    /**
+     * Send multiple datagrams.
+     *
+     * @param buffer Input buffer with DatagramHeader and payload pairs.
+     * @param size Number of bytes in the buffer.
+     *
+     * @return Number of bytes sent on success, Error on failure.
+     */
+    Error writeBatched(IOBuffer & buffer, Size size);
+
   private:
 
     /** UDP protocol instance */
@@ -112,8 +166,11 @@ class UDPSocket : public NetworkSocket
     /** Local port */
     u16 m_port;
 
-    /** Incoming packet queue */
-    NetworkQueue m_queue;
+    /** Incoming datagrams */
+    Queue<Datagram, UDPSOCKET_QUEUE_SIZE> m_queue;
+
+    /** Packets for copied datagrams */
+    NetworkQueue m_copies;
 };
 
 /**
@@ -46,6 +46,7 @@ class FileDescriptor
         mount    = 0;
         path[0]  = ZERO;
         position = 0;
+        handle   = 0;
         open     = false;
     }
 
@@ -53,6 +54,7 @@ class FileDescriptor
     {
         mount    = fd.mount;
         position = fd.position;
+        handle   = fd.handle;
         open     = fd.open;
         strlcpy(path, fd.path, PATH_MAX);
     }
@@ -79,6 +81,9 @@ class FileDescriptor
     /** Current position indicator. */
     Size position;
 
+    /** Open file handle on the mount, or zero to use the path. */
+    Size handle;
+
     /** State of the file descriptor. */
     bool open;
 };
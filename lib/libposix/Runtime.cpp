@@ -44,6 +44,20 @@ extern void (*DTOR_LIST)();
 /** FileSystem mounts table */
 static FileSystemMount mounts[FILESYSTEM_MAXMOUNTS];
 
+/** Shared data window with a FileSystem. */
+typedef struct FileShare
+{
+    /** ProcessID of the FileSystem or ZERO if unused. */
+    ProcessID mount;
+
+    /** Window in our address space or ZERO if not available. */
+    u8 *data;
+}
+FileShare;
+
+/** Shared data windows per FileSystem */
+static FileShare shares[FILESYSTEM_MAXMOUNTS];
+
 /** Table with FileDescriptors. */
 static FileDescriptor *files = (FileDescriptor *) NULL;
 
@@ -255,6 +269,51 @@ FileSystemMount * getMounts()
     return mounts;
 }
 
+u8 * getFileShare(ProcessID mount)
+{
+    FileShare *sh = ZERO;
+
+    if (!mount)
+        return ZERO;
+
+    // Do we have a window with this FileSystem already?
+    for (Size i = 0; i < FILESYSTEM_MAXMOUNTS; i++)
+    {
+        if (shares[i].mount == mount)
+            return shares[i].data;
+        else if (!shares[i].mount && !sh)
+            sh = &shares[i];
+    }
+
+    if (!sh)
+        return ZERO;
+
+    // Create the window. Remember failures to avoid retrying each time.
+    SystemInformation info;
+    ProcessShares::MemoryShare share;
+    share.pid    = mount;
+    share.coreId = info.coreId;
+    share.tagId  = FILESYSTEM_SHARE_TAG;
+    share.range.size = FILESYSTEM_SHARE_SIZE;
+    share.range.virt = 0;
+    share.range.phys = 0;
+    share.range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    switch (VMShare(mount, API::Create, &share))
+    {
+        case API::Success:
+        case API::AlreadyExists:
+            sh->data = (u8 *) share.range.virt;
+            break;
+
+        default:
+            sh->data = ZERO;
+            break;
+    }
+    sh->mount = mount;
+    return sh->data;
+}
+
 FileDescriptor * getFiles(void)
 {
     return files;
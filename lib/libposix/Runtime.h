@@ -98,6 +98,17 @@ FileDescriptor * getFiles();
  */
 FileSystemMount * getMounts();
 
+/**
+ * Get the shared data window with a FileSystem.
+ *
+ * Creates the window of FILESYSTEM_SHARE_SIZE bytes on first use.
+ *
+ * @param mount ProcessID of the FileSystem.
+ *
+ * @return Pointer to the window or ZERO if not available.
+ */
+u8 * getFileShare(ProcessID mount);
+
 /**
  * Get current directory String.
  *
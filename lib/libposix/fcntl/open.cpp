@@ -45,7 +45,7 @@ int open(const char *path, int oflag, ...)
 
     // Fill message
     msg.type   = ChannelMessage::Request;
-    msg.action = StatFile;
+    msg.action = OpenFile;
     msg.path   = fullpath;
     msg.stat   = &st;
 
@@ -77,6 +77,7 @@ int open(const char *path, int oflag, ...)
                     files[i].mount = mnt;
                     files[i].identifier = 0;
                     files[i].position = 0;
+                    files[i].handle = msg.handle;
                     strlcpy(files[i].path, fullpath, PATH_MAX);
                     return i;
                 }
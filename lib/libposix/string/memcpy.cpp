@@ -15,15 +15,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <MemoryBlock.h>
 #include "string.h"
 
 void * memcpy(void *dest, const void *src, size_t count)
 {
-    const char *sp = (const char *)src;
-    char *dp = (char *)dest;
-
-    for(; count != 0; count--)
-        *dp++ = *sp++;
-
+    MemoryBlock::copy(dest, src, count);
     return (dest);
 }
@@ -151,6 +151,22 @@ extern C int forkexec(const char *path, const char *argv[]);
  */
 extern C int spawn(Address program, Size programSize, const char *command);
 
+/**
+ * @brief Execute a program on the processor core with the least load.
+ *
+ * The program is loaded into physically contiguous memory and
+ * passed to the CoreServer, which spawns it on the core with the
+ * fewest runnable processes. Unlike forkexec(), the new process
+ * is not a child of the caller and cannot be waited for.
+ *
+ * @param path File to execute.
+ * @param argv Argument list pointer.
+ *
+ * @return Zero on success and -1 on failure.
+ * @note  Errno is set with the appropriate error code on failure.
+ */
+extern C int spawnany(const char *path, const char *argv[]);
+
 /**
  * @brief Get name of current host.
  *
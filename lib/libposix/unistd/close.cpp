@@ -23,6 +23,7 @@
 
 int close(int fildes)
 {
+    FileSystemMessage msg;
     FileDescriptor *files = getFiles();
 
     if (fildes >= FILE_DESCRIPTOR_MAX || fildes < 0)
@@ -37,6 +38,18 @@ int close(int fildes)
         return -1;
     }
 
+    // Release the open file handle on the filesystem
+    if (files[fildes].handle)
+    {
+        msg.type   = ChannelMessage::Request;
+        msg.action = CloseFile;
+        msg.path   = files[fildes].path;
+        msg.handle = files[fildes].handle;
+        msg.from   = SELF;
+        ChannelClient::instance->syncSendReceive(&msg, files[fildes].mount);
+        files[fildes].handle = 0;
+    }
+
     files[fildes].open = false;
     return 0;
 }
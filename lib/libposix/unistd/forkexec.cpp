@@ -19,6 +19,7 @@
 #include <ExecutableFormat.h>
 #include <Types.h>
 #include <Runtime.h>
+#include <MemoryBlock.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <errno.h>
@@ -95,7 +96,6 @@ int forkexec(const char *path, const char *argv[])
 
     // Not needed anymore
     delete fmt;
-    delete image;
 
     // Map program regions into virtual memory of the new process
     for (Size i = 0; i < numRegions; i++)
@@ -112,17 +112,25 @@ int forkexec(const char *path, const char *argv[])
         // Create mapping first
         if (VMCtl(pid, Map, &range) != 0)
         {
+            delete image;
             errno = EFAULT;
             return -1;
         }
-        // Copy bytes
+        // Copy bytes from the program image
         VMCopy(pid, API::Write, (Address) regions[i].data,
-               regions[i].virt, regions[i].size);
+               regions[i].virt, regions[i].dataSize);
 
-        // Release buffer
-        delete regions[i].data;
+        // Zero-fill the remainder without a buffer
+        if (regions[i].size > regions[i].dataSize)
+        {
+            VMCopy(pid, API::Zero, ZERO, regions[i].virt + regions[i].dataSize,
+                   regions[i].size - regions[i].dataSize);
+        }
     }
 
+    // Regions point inside the image
+    delete image;
+
     // Create mapping for command-line arguments
     range = map.range(MemoryMap::UserArgs);
     range.phys = ZERO;
@@ -152,15 +160,29 @@ int forkexec(const char *path, const char *argv[])
         return -1;
     }
 
+    // Open file handles belong to this process. Clear them in
+    // the copy for the child, such that it falls back to the path.
+    Size filesSize = sizeof(FileDescriptor) * FILE_DESCRIPTOR_MAX;
+    FileDescriptor *files = new FileDescriptor[FILE_DESCRIPTOR_MAX];
+    MemoryBlock::copy(files, getFiles(), filesSize);
+
+    for (Size i = 0; i < FILE_DESCRIPTOR_MAX; i++)
+        files[i].handle = 0;
+
+    if (filesSize > range.size - (PAGESIZE * 2))
+        filesSize = range.size - (PAGESIZE * 2);
+
     // Copy fds into the new process.
-    if ((VMCopy(pid, API::Write, (Address) getFiles(),
-                range.virt + (PAGESIZE * 2), range.size - (PAGESIZE * 2))) < 0)
+    if ((VMCopy(pid, API::Write, (Address) files,
+                range.virt + (PAGESIZE * 2), filesSize)) < 0)
     {
         delete[] arguments;
+        delete[] files;
         errno = EFAULT;
         ProcessCtl(pid, KillPID);
         return -1;
     }
+    delete[] files;
 
     // Let the Child begin execution
     ProcessCtl(pid, Resume);
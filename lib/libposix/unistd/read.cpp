@@ -17,6 +17,7 @@
 
 #include <FreeNOS/System.h>
 #include <FileSystemMessage.h>
+#include <MemoryBlock.h>
 #include "Runtime.h"
 #include <errno.h>
 #include "unistd.h"
@@ -39,23 +40,45 @@ ssize_t read(int fildes, void *buf, size_t nbyte)
         return -1;
     }
 
+    // Bulk reads go through the shared data window, if available
+    u8 *shared = nbyte >= FILESYSTEM_SHARE_MIN ?
+                 getFileShare(files[fildes].mount) : ZERO;
+    Size total = 0, chunk;
+
     // Read the file.
-    msg.type   = ChannelMessage::Request;
-    msg.action = ReadFile;
     msg.path   = files[fildes].path;
-    msg.buffer = (char *) buf;
-    msg.size   = nbyte;
-    msg.offset = files[fildes].position;
+    msg.handle = files[fildes].handle;
+    msg.shared = shared != ZERO;
     msg.from   = SELF;
     msg.deviceID.minor = files[fildes].identifier;
-    ChannelClient::instance->syncSendReceive(&msg, files[fildes].mount);
 
-    // Did we read something?
-    if (msg.result >= 0)
+    do
     {
+        chunk = nbyte - total;
+        if (shared && chunk > FILESYSTEM_SHARE_SIZE)
+            chunk = FILESYSTEM_SHARE_SIZE;
+
+        msg.type   = ChannelMessage::Request;
+        msg.action = ReadFile;
+        msg.buffer = shared ? ZERO : (char *) buf + total;
+        msg.size   = chunk;
+        msg.offset = files[fildes].position;
+        ChannelClient::instance->syncSendReceive(&msg, files[fildes].mount);
+
+        if (msg.result < 0)
+            break;
+
+        if (shared)
+            MemoryBlock::copy((u8 *) buf + total, shared, msg.result);
+
         files[fildes].position += msg.result;
-        return msg.result;
+        total += msg.result;
     }
+    while (shared && (Size) msg.result == chunk && total < nbyte);
+
+    // Did we read something?
+    if (msg.result >= 0 || total > 0)
+        return total;
 
     // Set error code
     errno = msg.result;
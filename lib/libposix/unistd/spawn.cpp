@@ -87,12 +87,16 @@ int spawn(Address program, Size programSize, const char *command)
             return -1;
         }
 
-        // Copy bytes
+        // Copy bytes from the program image
         VMCopy(pid, API::Write, (Address) regions[i].data,
-               regions[i].virt, regions[i].size);
+               regions[i].virt, regions[i].dataSize);
 
-        // Release data buffer
-        delete regions[i].data;
+        // Zero-fill the remainder without a buffer
+        if (regions[i].size > regions[i].dataSize)
+        {
+            VMCopy(pid, API::Zero, ZERO, regions[i].virt + regions[i].dataSize,
+                   regions[i].size - regions[i].dataSize);
+        }
     }
 
     // Create mapping for command-line arguments
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <FileSystemMessage.h>
+#include <MemoryBlock.h>
+#include <CoreInfo.h>
+#include <Runtime.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include "unistd.h"
+
+int spawnany(const char *path, const char *argv[])
+{
+    FileSystemMessage msg;
+    Memory::Range range;
+    struct stat st;
+    char *cmd;
+    u8 *image;
+    int fd;
+
+    // Find program image
+    if (stat(path, &st) != 0)
+        return -1;
+
+    // The CoreServer needs the command and program in contiguous physical memory
+    range.size   = PAGESIZE + st.st_size;
+    range.size  += PAGESIZE - (range.size % PAGESIZE);
+    range.phys   = 0;
+    range.virt   = 0;
+    range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(SELF, Map, &range) != API::Success)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+    cmd   = (char *) range.virt;
+    image = (u8 *) range.virt + PAGESIZE;
+
+    // Read the program image
+    if ((fd = open(path, O_RDONLY)) < 0 || read(fd, image, st.st_size) != st.st_size)
+    {
+        if (fd >= 0)
+            close(fd);
+
+        VMCtl(SELF, Release, &range);
+        return -1;
+    }
+    close(fd);
+
+    // Fill in the command line
+    MemoryBlock::set(cmd, 0, ARGV_SIZE);
+    strlcpy(cmd, path, ARGV_SIZE);
+
+    for (Size i = 1; argv[0] && argv[i]; i++)
+    {
+        Size len = strlen(cmd);
+
+        if (len + strlen(argv[i]) + 1 >= ARGV_SIZE)
+            break;
+
+        cmd[len] = ' ';
+        strlcpy(cmd + len + 1, argv[i], ARGV_SIZE - len - 1);
+    }
+
+    // Let the CoreServer place the program
+    msg.type   = ChannelMessage::Request;
+    msg.action = CreateFile;
+    msg.size   = COREINFO_ANY_CORE;
+    msg.buffer = (char *) image;
+    msg.offset = st.st_size;
+    msg.path   = cmd;
+    msg.from   = SELF;
+    ChannelClient::instance->syncSendReceive(&msg, CORESRV_PID);
+
+    // The program has been copied into the new process
+    VMCtl(SELF, Release, &range);
+
+    if (msg.result != ESUCCESS)
+    {
+        errno = msg.result;
+        return -1;
+    }
+    return 0;
+}
@@ -18,12 +18,22 @@
 #include "BitArray.h"
 #include "MemoryBlock.h"
 
+/** Word type which may alias the byte array. */
+typedef u32 __attribute__((__may_alias__)) BitWord;
+
+/** Number of bits in a word. */
+#define WORD_BITS 32
+
+/** Mask of all bits in a word from the given bit and up. */
+#define WORD_MASK_FROM(bit) (~0U << (bit))
+
 BitArray::BitArray(Size size, u8 *array)
 {
     m_array = array ? array : new u8[BITS_TO_BYTES(size)];
     m_allocated = array == ZERO;
     m_size  = size;
     m_set   = 0;
+    m_hint  = 0;
     clear();
 }
 
@@ -67,6 +77,9 @@ void BitArray::set(Size bit, bool value)
         {
             m_array[bit / 8] &= ~(1 << (bit % 8));
             m_set--;
+
+            if (bit < m_hint)
+                m_hint = bit;
         }
     }
 }
@@ -86,47 +99,141 @@ bool BitArray::isSet(Size bit) const
 
 void BitArray::setRange(Size from, Size to)
 {
-    for (Size i = from; i <= to; i++)
-        set(i, true);
+    if (!m_size)
+        return;
+
+    if (to >= m_size)
+        to = m_size - 1;
+
+    // Set whole words at once, masking the first and last word
+    for (Size word = from / WORD_BITS; from <= to && word <= to / WORD_BITS; word++)
+    {
+        u32 mask = ~0U;
+
+        if (word == from / WORD_BITS)
+            mask &= WORD_MASK_FROM(from % WORD_BITS);
+
+        if (word == to / WORD_BITS && (to % WORD_BITS) != WORD_BITS - 1)
+            mask &= ~WORD_MASK_FROM((to % WORD_BITS) + 1);
+
+        u32 value = getWord(word);
+        m_set += __builtin_popcount(mask & ~value);
+        setWord(word, value | mask);
+    }
 }
 
 BitArray::Result BitArray::setNext(Size *bit, Size count, Size start, Size boundary)
 {
-    Size from = 0, found = 0;
+    Size from = start > m_hint ? start : m_hint;
 
-    // Loop BitArray for unset bits
-    for (Size i = start; i < m_size; i++)
+    if (!boundary)
+        return InvalidArgument;
+
+    if (!count)
+        count = 1;
+
+    while (from < m_size && count <= m_size - from)
     {
-        if (!isSet(i))
+        // Find the next unset bit
+        Size first = findUnset(from);
+
+        // Nothing is unset between the hint and here
+        if (from == m_hint)
+            m_hint = first;
+
+        if (first >= m_size)
+            break;
+
+        if (first % boundary)
         {
-            // Remember this bit
-            if (!found)
-            {
-                if (i % boundary)
-                    continue;
-                from  = i;
-                found = 1;
-            }
-            else
-                found++;
-
-            // Are there enough contigious bits?
-            if (found >= count)
-            {
-                setRange(from, i);
-                *bit = from;
-                return Success;
-            }
+            from = first + boundary - (first % boundary);
+            continue;
         }
-        else
+        if (count > m_size - first)
+            break;
+
+        // Are there enough contiguous bits?
+        Size used = findSet(first, first + count);
+        if (used == first + count)
         {
-            from = found = 0;
+            setRange(first, first + count - 1);
+            *bit = first;
+            return Success;
         }
+        from = used + 1;
     }
     // No unset bits left!
     return OutOfMemory;
 }
 
+u32 BitArray::getWord(Size word) const
+{
+    Size byte  = word * sizeof(u32);
+    Size bytes = BITS_TO_BYTES(m_size);
+    u32 value  = 0;
+
+    if (!((Address) m_array % sizeof(u32)) && byte + sizeof(u32) <= bytes)
+        value = ((const BitWord *) m_array)[word];
+    else
+    {
+        for (Size i = 0; i < sizeof(u32) && byte + i < bytes; i++)
+            value |= m_array[byte + i] << (i * 8);
+    }
+    // Ignore bits beyond the end of the array
+    if ((word + 1) * WORD_BITS > m_size)
+        value &= ~WORD_MASK_FROM(m_size % WORD_BITS);
+
+    return value;
+}
+
+void BitArray::setWord(Size word, u32 value)
+{
+    Size byte  = word * sizeof(u32);
+    Size bytes = BITS_TO_BYTES(m_size);
+
+    if (!((Address) m_array % sizeof(u32)) && byte + sizeof(u32) <= bytes)
+        ((BitWord *) m_array)[word] = value;
+    else
+    {
+        for (Size i = 0; i < sizeof(u32) && byte + i < bytes; i++)
+            m_array[byte + i] = value >> (i * 8);
+    }
+}
+
+Size BitArray::findUnset(Size from) const
+{
+    Size word = from / WORD_BITS;
+    u32 unset = ~getWord(word) & WORD_MASK_FROM(from % WORD_BITS);
+
+    // Skip full words
+    while (!unset)
+    {
+        if (++word * WORD_BITS >= m_size)
+            return m_size;
+
+        unset = ~getWord(word);
+    }
+    Size bit = (word * WORD_BITS) + __builtin_ctz(unset);
+    return bit < m_size ? bit : m_size;
+}
+
+Size BitArray::findSet(Size from, Size to) const
+{
+    Size word = from / WORD_BITS;
+    u32 set = getWord(word) & WORD_MASK_FROM(from % WORD_BITS);
+
+    // Skip empty words
+    while (!set)
+    {
+        if (++word * WORD_BITS >= to)
+            return to;
+
+        set = getWord(word);
+    }
+    Size bit = (word * WORD_BITS) + __builtin_ctz(set);
+    return bit < to ? bit : to;
+}
+
 u8 * BitArray::array() const
 {
     return m_array;
@@ -146,11 +253,11 @@ void BitArray::setArray(u8 *map, Size size)
     m_array = map;
     m_allocated = false;
     m_set   = 0;
+    m_hint  = 0;
 
     // Recalculate set bits
-    for (Size i = 0; i < m_size; i++)
-        if (isSet(i))
-            m_set++;
+    for (Size i = 0; i < m_size; i += WORD_BITS)
+        m_set += __builtin_popcount(getWord(i / WORD_BITS));
 }
 
 void BitArray::clear()
@@ -159,7 +266,8 @@ void BitArray::clear()
     MemoryBlock::set(m_array, 0, BITS_TO_BYTES(m_size));
 
     // Reset set count
-    m_set = 0;
+    m_set  = 0;
+    m_hint = 0;
 }
 
 bool BitArray::operator[](Size bit) const
@@ -35,6 +35,10 @@
 
 /**
  * Represents an array of bits.
+ *
+ * Searching and setting ranges works on 32-bit words at a time.
+ * The array keeps a hint to the lowest bit which may be unset,
+ * such that searches skip the fully used start of the array.
  */
 class BitArray
 {
@@ -163,6 +167,44 @@ class BitArray
      */
     bool operator[](int bit) const;
 
+  private:
+
+    /**
+     * Read a 32-bit word of the array.
+     *
+     * @param word Index of the word.
+     *
+     * @return Bits of the word, with bits beyond the array unset.
+     */
+    u32 getWord(Size word) const;
+
+    /**
+     * Write a 32-bit word of the array.
+     *
+     * @param word Index of the word.
+     * @param value New bits of the word.
+     */
+    void setWord(Size word, u32 value);
+
+    /**
+     * Find the first unset bit.
+     *
+     * @param from Bit to start searching at.
+     *
+     * @return Bit number or size() if none found.
+     */
+    Size findUnset(Size from) const;
+
+    /**
+     * Find the first set bit within a range.
+     *
+     * @param from Bit to start searching at.
+     * @param to End bit (exclusive), at most size().
+     *
+     * @return Bit number or the value of to if none found.
+     */
+    Size findSet(Size from, Size to) const;
+
   private:
 
     /** Total number of bits in the array. */
@@ -171,6 +213,9 @@ class BitArray
     /** Set bits in the array. */
     Size m_set;
 
+    /** All bits below this bit are set. */
+    Size m_hint;
+
     /** Array containing the bits. */
     u8 *m_array;
 
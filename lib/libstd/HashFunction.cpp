@@ -20,18 +20,10 @@
 
 Size hash(const String & key, Size mod)
 {
-    Size ret  = FNV_INIT;
-    Size size = key.length();
-
     assertRead(key);
     assert(mod > 0);
 
-    for (Size i = 0; i < size; i++)
-    {
-        ret *= FNV_PRIME;
-        ret ^= key[i];
-    }
-    return (ret % mod);
+    return (key.hash() % mod);
 }
 
 Size hash(int key, Size mod)
@@ -20,7 +20,6 @@
 
 #include "Types.h"
 #include "Macros.h"
-#include "Vector.h"
 #include "List.h"
 #include "ListIterator.h"
 #include "HashFunction.h"
@@ -30,6 +29,9 @@
 /** Default size of the HashTable internal table. */
 #define HASHTABLE_DEFAULT_SIZE    64
 
+/** The table grows when it would become more than 3/4 full. */
+#define HASHTABLE_LOAD_FACTOR(size) (((size) * 3) / 4)
+
 /**
  * @addtogroup lib
  * @{
@@ -40,6 +42,13 @@
 
 /**
  * Efficient key -> value lookups.
+ *
+ * Uses open addressing with Robin Hood linear probing. Each slot
+ * caches the full hash of its key and its distance from the home slot.
+ * Lookups stop as soon as they pass the position where the key would
+ * have been stored. Entries stay sorted by home slot, so appended values
+ * for the same key keep their order. The table doubles in size when the
+ * load factor is exceeded.
  */
 template <class K, class V> class HashTable : public Associative<K,V>
 {
@@ -106,18 +115,42 @@ template <class K, class V> class HashTable : public Associative<K,V>
     /**
      * Class constructor.
      *
-     * @param size Initial size of the internal table.
+     * @param size Initial size of the internal table. Rounded up to a power of two.
      */
     HashTable(Size size = HASHTABLE_DEFAULT_SIZE)
-        : m_table(size)
     {
         assert(size > 0);
 
+        m_size  = 1;
         m_count = ZERO;
 
-        // Fill the Vector with empty Bucket Lists.
-        for (Size i = 0; i < m_table.size(); i++)
-            m_table.insert(List<Bucket>());
+        while (m_size < size)
+            m_size <<= 1;
+
+        m_slots = new Slot[m_size];
+    }
+
+    /**
+     * Copy constructor.
+     *
+     * @param h HashTable to copy.
+     */
+    HashTable(const HashTable<K,V> & h)
+    {
+        m_size  = h.m_size;
+        m_count = h.m_count;
+        m_slots = new Slot[m_size];
+
+        for (Size i = 0; i < m_size; i++)
+            m_slots[i] = h.m_slots[i];
+    }
+
+    /**
+     * Destructor.
+     */
+    virtual ~HashTable()
+    {
+        delete[] m_slots;
     }
 
     /**
@@ -135,22 +168,18 @@ template <class K, class V> class HashTable : public Associative<K,V>
         assertRead(key);
         assertRead(value);
 
-        Size idx = hash(key, m_table.size());
+        Size h = hashOf(key);
+        Size idx = find(key, h);
 
         // See if the given key exists. Overwrite if so.
-        for (ListIterator<Bucket> i(m_table[idx]); i.hasCurrent(); i++)
+        if (idx != m_size)
         {
-            if (i.current().key == key)
-            {
-                i.current().value = value;
-                return true;
-            }
+            m_slots[idx].bucket.value = value;
+            return true;
         }
 
         // Key does not exist. Append it.
-        m_table[idx].append(Bucket(key, value));
-        m_count++;
-        return true;
+        return append(key, value);
     }
 
     /**
@@ -166,8 +195,10 @@ template <class K, class V> class HashTable : public Associative<K,V>
         assertRead(key);
         assertRead(value);
 
-        // Always append
-        m_table[hash(key, m_table.size())].append(Bucket(key, value));
+        if (m_count + 1 > HASHTABLE_LOAD_FACTOR(m_size))
+            resize(m_size * 2);
+
+        place(hashOf(key), Bucket(key, value));
         m_count++;
         return true;
     }
@@ -181,18 +212,15 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual int remove(const K & key)
     {
+        Size h = hashOf(key);
+        Size idx;
         int removed = 0;
 
-        for (ListIterator<Bucket> i(m_table[hash(key, m_table.size())]); i.hasCurrent(); )
+        while ((idx = find(key, h)) != m_size)
         {
-            if (i.current().key == key)
-            {
-                i.remove();
-                m_count--;
-                removed++;
-            }
-            else
-                i++;
+            erase(idx);
+            m_count--;
+            removed++;
         }
         return removed;
     }
@@ -204,7 +232,7 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual Size size() const
     {
-        return m_table.size();
+        return m_size;
     }
 
     /**
@@ -217,6 +245,16 @@ template <class K, class V> class HashTable : public Associative<K,V>
         return m_count;
     }
 
+    /**
+     * Check if the given key exists.
+     *
+     * @return True if exists, false otherwise.
+     */
+    virtual bool contains(const K & key) const
+    {
+        return find(key, hashOf(key)) != m_size;
+    }
+
     /**
      * Retrieve all keys inside the Association.
      *
@@ -226,10 +264,10 @@ template <class K, class V> class HashTable : public Associative<K,V>
     {
         List<K> lst;
 
-        for (Size i = 0; i < m_table.count(); i++)
-            for (ListIterator<Bucket> j(m_table[i]); j.hasCurrent(); j++)
-                if (!lst.contains(j.current().key))
-                    lst << j.current().key;
+        // Only report the first slot of each key
+        for (Size i = 0; i < m_size; i++)
+            if (m_slots[i].probe && find(m_slots[i].bucket.key, m_slots[i].hash) == i)
+                lst << m_slots[i].bucket.key;
 
         return lst;
     }
@@ -241,10 +279,10 @@ template <class K, class V> class HashTable : public Associative<K,V>
     {
         List<K> lst;
 
-        for (Size i = 0; i < m_table.count(); i++)
-            for (ListIterator<Bucket> j(m_table[i]); j.hasCurrent(); j++)
-                if (j.current().value == value && !lst.contains(j.current().key))
-                    lst << j.current().key;
+        for (Size i = 0; i < m_size; i++)
+            if (m_slots[i].probe && m_slots[i].bucket.value == value &&
+                !lst.contains(m_slots[i].bucket.key))
+                lst << m_slots[i].bucket.key;
 
         return lst;
     }
@@ -258,9 +296,9 @@ template <class K, class V> class HashTable : public Associative<K,V>
     {
         List<V> lst;
 
-        for (Size i = 0; i < m_table.count(); i++)
-            for (ListIterator<Bucket> j(m_table[i]); j.hasCurrent(); j++)
-                lst << j.current().value;
+        for (Size i = 0; i < m_size; i++)
+            if (m_slots[i].probe)
+                lst << m_slots[i].bucket.value;
 
         return lst;
     }
@@ -273,11 +311,17 @@ template <class K, class V> class HashTable : public Associative<K,V>
     virtual List<V> values(const K & key) const
     {
         List<V> lst;
+        Size h = hashOf(key);
+        Size idx = h & (m_size - 1);
 
-        for (ListIterator<Bucket> i(m_table[hash(key, m_table.size())]); i.hasCurrent(); i++)
-            if (i.current().key == key)
-                lst << i.current().value;
+        // Walk the probe sequence of the key
+        for (Size dist = 1; m_slots[idx].probe >= dist; dist++)
+        {
+            if (m_slots[idx].hash == h && m_slots[idx].bucket.key == key)
+                lst << m_slots[idx].bucket.value;
 
+            idx = (idx + 1) & (m_size - 1);
+        }
         return lst;
     }
 
@@ -290,13 +334,9 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual const V * get(const K & key) const
     {
-        const List<Bucket> & lst = m_table[hash(key, m_table.size())];
-
-        for (ListIterator<Bucket> i(lst); i.hasCurrent(); i++)
-            if (i.current().key == key)
-                return &i.current().value;
+        Size idx = find(key, hashOf(key));
 
-        return ZERO;
+        return idx != m_size ? &m_slots[idx].bucket.value : ZERO;
     }
 
     /**
@@ -310,13 +350,9 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual const V & at(const K & key) const
     {
-        const List<Bucket> & lst = m_table[hash(key, m_table.size())];
+        Size idx = find(key, hashOf(key));
 
-        for (ListIterator<Bucket> i(lst); i.hasCurrent(); i++)
-            if (i.current().key == key)
-                return i.current().value;
-
-        return m_table[0].head()->data.value;
+        return m_slots[idx != m_size ? idx : 0].bucket.value;
     }
 
     /**
@@ -328,23 +364,46 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual const V value(const K & key, const V defaultValue = V()) const
     {
-        const List<Bucket> & lst = m_table[hash(key, m_table.size())];
-
-        for (ListIterator<Bucket> i(lst); i.hasCurrent(); i++)
-            if (i.current().key == key)
-                return i.current().value;
+        Size idx = find(key, hashOf(key));
 
-        return defaultValue;
+        return idx != m_size ? m_slots[idx].bucket.value : defaultValue;
     }
 
     /**
-     * Get the internal Vector with Buckets.
+     * Change the size of the internal table.
+     *
+     * @param size New size. Rounded up to a power of two.
      *
-     * @return Reference to the Vector with Buckets.
+     * @return True if resized, false if the items would not fit.
      */
-    Vector<List<Bucket> > & table()
+    virtual bool resize(Size size)
     {
-        return m_table;
+        Slot *old = m_slots;
+        Size oldSize = m_size, start = 0, newSize = 1;
+
+        while (newSize < size)
+            newSize <<= 1;
+
+        if (m_count > HASHTABLE_LOAD_FACTOR(newSize))
+            return false;
+
+        m_slots = new Slot[newSize];
+        m_size  = newSize;
+
+        // Start after an empty slot, such that runs which wrap
+        // around the end keep their order.
+        while (old[start].probe)
+            start++;
+
+        for (Size i = 0; i < oldSize; i++)
+        {
+            Slot *s = &old[(start + i) & (oldSize - 1)];
+
+            if (s->probe)
+                place(s->hash, s->bucket);
+        }
+        delete[] old;
+        return true;
     }
 
     /**
@@ -365,10 +424,125 @@ template <class K, class V> class HashTable : public Associative<K,V>
 
   private:
 
+    /**
+     * Slot in the internal table.
+     */
+    typedef struct Slot
+    {
+        /**
+         * Default constructor.
+         */
+        Slot() : hash(0), probe(0)
+        {
+        }
+
+        /** Cached hash of the key. */
+        Size hash;
+
+        /** Distance from the home slot plus one, or zero if unused. */
+        Size probe;
+
+        /** Key and value. */
+        Bucket bucket;
+    }
+    Slot;
+
+    /**
+     * Compute the full hash of a key.
+     */
+    static Size hashOf(const K & key)
+    {
+        return hash(key, ~((Size) 0));
+    }
+
+    /**
+     * Find the first slot of a key.
+     *
+     * @param key Key to find.
+     * @param h Full hash of the key.
+     *
+     * @return Index of the slot or the table size if not found.
+     */
+    Size find(const K & key, Size h) const
+    {
+        Size idx = h & (m_size - 1);
+
+        // Stop when passing the position the key would have
+        for (Size dist = 1; m_slots[idx].probe >= dist; dist++)
+        {
+            if (m_slots[idx].hash == h && m_slots[idx].bucket.key == key)
+                return idx;
+
+            idx = (idx + 1) & (m_size - 1);
+        }
+        return m_size;
+    }
+
+    /**
+     * Store a bucket in the table.
+     *
+     * The bucket is placed after all entries with the same or an
+     * earlier home slot. Following entries are shifted one slot up.
+     *
+     * @param h Full hash of the key.
+     * @param bucket Key and value to store.
+     */
+    void place(Size h, const Bucket & bucket)
+    {
+        Size mask = m_size - 1;
+        Size idx = h & mask, dist = 1, end;
+
+        // Find the position
+        while (m_slots[idx].probe >= dist)
+        {
+            idx = (idx + 1) & mask;
+            dist++;
+        }
+
+        // Shift the rest of the run up to the next free slot
+        for (end = idx; m_slots[end].probe; end = (end + 1) & mask)
+            ;
+
+        for (; end != idx; end = (end - 1) & mask)
+        {
+            m_slots[end] = m_slots[(end - 1) & mask];
+            m_slots[end].probe++;
+        }
+
+        m_slots[idx].hash   = h;
+        m_slots[idx].probe  = dist;
+        m_slots[idx].bucket = bucket;
+    }
+
+    /**
+     * Remove the entry in a slot.
+     *
+     * Shifts the following entries of the run one slot down.
+     *
+     * @param idx Index of the slot to clear.
+     */
+    void erase(Size idx)
+    {
+        Size mask = m_size - 1;
+        Size next = (idx + 1) & mask;
+
+        while (m_slots[next].probe > 1)
+        {
+            m_slots[idx] = m_slots[next];
+            m_slots[idx].probe--;
+            idx  = next;
+            next = (next + 1) & mask;
+        }
+        m_slots[idx] = Slot();
+    }
+
     /** Internal table. */
-    Vector<List<Bucket> > m_table;
+    Slot *m_slots;
+
+    /** Number of slots in the table. Always a power of two. */
+    Size m_size;
 
-    /** Number of values in the buckets. */
+    /** Number of values in the table. */
     Size m_count;
 };
 
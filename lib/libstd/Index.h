@@ -36,6 +36,9 @@
 
 /**
  * Index is a resizable array of pointers to items.
+ *
+ * Unused positions are kept on a stack, such that inserting
+ * and removing items takes constant time.
  */
 template <class T> class Index : public Sequence<T>
 {
@@ -50,12 +53,18 @@ template <class T> class Index : public Sequence<T>
      */
     Index(Size size = INDEX_DEFAULT_SIZE)
     {
+        assert(size > 0);
+
         m_size  = size;
         m_count = 0;
         m_array = new T*[size];
+        m_free  = new Size[size];
+        m_slot  = new Size[size];
 
         for (Size i = 0; i < size; i++)
             m_array[i] = ZERO;
+
+        rebuildFree();
     }
 
     /**
@@ -64,6 +73,8 @@ template <class T> class Index : public Sequence<T>
     virtual ~Index()
     {
         delete[] m_array;
+        delete[] m_free;
+        delete[] m_slot;
     }
 
     /**
@@ -75,19 +86,15 @@ template <class T> class Index : public Sequence<T>
      */
     virtual int insert(const T & item)
     {
-        if (m_count == m_size)
-            this->resize(m_size * 2);
+        Size position;
 
-        for (Size i = 0; i < m_size; i++)
-        {
-            if (!m_array[i])
-            {
-                m_array[i] = (T *) &item;
-                m_count++;
-                return (int) i;
-            }
-        }
-        return -1;
+        if (!m_freeCount && !resize(m_size * 2))
+            return -1;
+
+        position = m_free[--m_freeCount];
+        m_array[position] = (T *) &item;
+        m_count++;
+        return (int) position;
     }
 
     /**
@@ -102,12 +109,18 @@ template <class T> class Index : public Sequence<T>
      */
     virtual bool insert(Size position, const T & item)
     {
-        if (position <= m_size)
-            this->resize(position * 2);
+        if (position >= m_size && !resize(position * 2))
+            return false;
 
         if (!m_array[position])
-            m_count++;
+        {
+            // Take the position off the free stack
+            Size top = m_free[--m_freeCount];
 
+            m_free[m_slot[position]] = top;
+            m_slot[top] = m_slot[position];
+            m_count++;
+        }
         m_array[position] = (T *) &item;
         return true;
     }
@@ -138,10 +151,24 @@ template <class T> class Index : public Sequence<T>
             return false;
 
         m_array[position] = ZERO;
+        m_slot[position] = m_freeCount;
+        m_free[m_freeCount++] = position;
         m_count--;
         return true;
     }
 
+    /**
+     * Removes all items from the Index.
+     */
+    virtual void clear()
+    {
+        for (Size i = 0; i < m_size; i++)
+            m_array[i] = ZERO;
+
+        m_count = 0;
+        rebuildFree();
+    }
+
     /**
      * Returns the item at the given position.
      *
@@ -226,8 +253,80 @@ template <class T> class Index : public Sequence<T>
         return m_count;
     }
 
+    /**
+     * Change the size of the Index.
+     *
+     * @param size New size of the Index.
+     *
+     * @return True if resized, false if an item is stored beyond the new size.
+     */
+    virtual bool resize(Size size)
+    {
+        T **arr;
+
+        assert(size > 0);
+
+        // Refuse to drop any items
+        for (Size i = size; i < m_size; i++)
+            if (m_array[i])
+                return false;
+
+        // Allocate new arrays
+        if (!(arr = new T*[size]))
+            return false;
+
+        // Copy the pointers and clear new positions
+        for (Size i = 0; i < size; i++)
+            arr[i] = i < m_size ? m_array[i] : ZERO;
+
+        delete[] m_array;
+        delete[] m_free;
+        delete[] m_slot;
+        m_array = arr;
+        m_free  = new Size[size];
+        m_slot  = new Size[size];
+        m_size  = size;
+        rebuildFree();
+        return true;
+    }
+
+    /**
+     * Shrink the Index to just above the last stored item.
+     *
+     * @return New size of the Index.
+     */
+    virtual Size squeeze()
+    {
+        Size size = m_size;
+
+        while (size > 1 && !m_array[size - 1])
+            size--;
+
+        resize(size);
+        return m_size;
+    }
+
   private:
 
+    /**
+     * Fill the free stack with all unused positions.
+     *
+     * The lowest positions end on top, such that they are used first.
+     */
+    void rebuildFree()
+    {
+        m_freeCount = 0;
+
+        for (Size i = m_size; i > 0; i--)
+        {
+            if (!m_array[i - 1])
+            {
+                m_slot[i - 1] = m_freeCount;
+                m_free[m_freeCount++] = i - 1;
+            }
+        }
+    }
+
     /** Array of pointers to items. */
     T** m_array;
 
@@ -236,6 +335,15 @@ template <class T> class Index : public Sequence<T>
 
     /** Amount of valid pointers in the array. */
     Size m_count;
+
+    /** Stack of unused positions. */
+    Size *m_free;
+
+    /** Position of each unused slot on the free stack. */
+    Size *m_slot;
+
+    /** Number of positions on the free stack. */
+    Size m_freeCount;
 };
 
 /**
@@ -18,23 +18,155 @@
 #include "Macros.h"
 #include "MemoryBlock.h"
 
+/** Machine word used for bulk operations. May alias any other type. */
+typedef unsigned long MemoryWord __attribute__((may_alias));
+
+/** Size of a MemoryWord in bytes. */
+#define WORD_SIZE sizeof(MemoryWord)
+
+/** Below this number of bytes the plain byte loop is used. */
+#define SMALL_SIZE (WORD_SIZE * 4)
+
+/**
+ * Check if an address is aligned on a MemoryWord boundary.
+ */
+#define WORD_ALIGNED(addr) ((((Address) (addr)) & (WORD_SIZE - 1)) == 0)
+
 void * MemoryBlock::set(void *dest, int ch, unsigned count)
 {
-    char *temp;
+    u8 *dst = (u8 *) dest;
+    MemoryWord pattern = (u8) ch;
+    Size words;
+
+    // Align the destination on a word boundary
+    if (count >= SMALL_SIZE)
+    {
+        while (!WORD_ALIGNED(dst))
+        {
+            *dst++ = ch;
+            count--;
+        }
+        pattern |= pattern << 8;
+        pattern |= pattern << 16;
+        pattern |= (pattern << 16) << 16;
+        words = count / WORD_SIZE;
+        count -= words * WORD_SIZE;
+
+#if defined(__i386__)
+        asm volatile ("rep stosl"
+                      : "+D" (dst), "+c" (words)
+                      : "a" (pattern)
+                      : "memory");
+#elif defined(__x86_64__)
+        asm volatile ("rep stosq"
+                      : "+D" (dst), "+c" (words)
+                      : "a" (pattern)
+                      : "memory");
+#else
+#if defined(__arm__)
+        // Store four words at once using STM
+        if (words >= 4)
+        {
+            Size blocks = words / 4;
+            words -= blocks * 4;
+
+            asm volatile ("mov r3, %2\n"
+                          "mov r4, %2\n"
+                          "mov r5, %2\n"
+                          "mov r6, %2\n"
+                          "1: stmia %0!, {r3-r6}\n"
+                          "subs %1, %1, #1\n"
+                          "bne 1b\n"
+                          : "+r" (dst), "+r" (blocks)
+                          : "r" (pattern)
+                          : "r3", "r4", "r5", "r6", "cc", "memory");
+        }
+#endif /* __arm__ */
+        for (; words != 0; words--)
+        {
+            *(MemoryWord *) dst = pattern;
+            dst += WORD_SIZE;
+        }
+#endif
+    }
 
-    for(temp = (char *) dest; count != 0; count--)
+    // Remaining bytes
+    for (; count != 0; count--)
     {
-        *temp++ = ch;
+        *dst++ = ch;
     }
     return (dest);
 }
 
 Size MemoryBlock::copy(void *dest, const void *src, Size count)
 {
-    const char *sp = (const char *)src;
-    char *dp = (char *)dest;
+    const u8 *sp = (const u8 *) src;
+    u8 *dp = (u8 *) dest;
+    Size words, bytes = count;
+
+#if defined(__i386__) || defined(__x86_64__)
+    // Intel handles unaligned loads, only align the destination
+    if (bytes >= SMALL_SIZE)
+    {
+        while (!WORD_ALIGNED(dp))
+        {
+            *dp++ = *sp++;
+            bytes--;
+        }
+        words = bytes / WORD_SIZE;
+        bytes -= words * WORD_SIZE;
+
+#if defined(__i386__)
+        asm volatile ("rep movsl"
+                      : "+D" (dp), "+S" (sp), "+c" (words)
+                      :
+                      : "memory");
+#else
+        asm volatile ("rep movsq"
+                      : "+D" (dp), "+S" (sp), "+c" (words)
+                      :
+                      : "memory");
+#endif
+    }
+#else
+    // Word copies require equal alignment of source and destination
+    if (bytes >= SMALL_SIZE && WORD_ALIGNED((Address) dp ^ (Address) sp))
+    {
+        while (!WORD_ALIGNED(dp))
+        {
+            *dp++ = *sp++;
+            bytes--;
+        }
+        words = bytes / WORD_SIZE;
+        bytes -= words * WORD_SIZE;
+
+#if defined(__arm__)
+        // Move four words at once using LDM/STM
+        if (words >= 4)
+        {
+            Size blocks = words / 4;
+            words -= blocks * 4;
+
+            asm volatile ("1: ldmia %1!, {r3-r6}\n"
+                          "stmia %0!, {r3-r6}\n"
+                          "subs %2, %2, #1\n"
+                          "bne 1b\n"
+                          : "+r" (dp), "+r" (sp), "+r" (blocks)
+                          :
+                          : "r3", "r4", "r5", "r6", "cc", "memory");
+        }
+#endif /* __arm__ */
+        for (; words != 0; words--)
+        {
+            *(MemoryWord *) dp = *(const MemoryWord *) sp;
+            dp += WORD_SIZE;
+            sp += WORD_SIZE;
+        }
+    }
+#endif
 
-    for(Size i = count; i != 0; i--)
+    // Remaining bytes
+    for (; bytes != 0; bytes--)
         *dp++ = *sp++;
 
     return (count);
@@ -82,6 +82,18 @@ template <class T, Size N> class Queue : public Container
         return m_array[idx];
     }
 
+    /**
+     * Get the item at the tail of the Queue without removing it.
+     *
+     * @return Item T which is returned by the next pop()
+     *
+     * @note Do not call this function if the Queue is empty
+     */
+    T & peek()
+    {
+        return m_array[m_tail];
+    }
+
     /**
      * Look if an item exists on the Queue
      *
@@ -17,24 +17,26 @@
 
 #include "Character.h"
 #include "MemoryBlock.h"
+#include "HashFunction.h"
 #include "String.h"
 
 String::String()
 {
-    m_string    = new char[STRING_DEFAULT_SIZE];
+    m_string    = m_inline;
     m_string[0] = ZERO;
     m_allocated = true;
     m_size      = STRING_DEFAULT_SIZE;
     m_count     = 0;
     m_base      = Number::Dec;
+    m_hash      = ZERO;
 }
 
 String::String(const String & str)
 {
-    m_size      = str.m_size;
     m_count     = str.m_count;
     m_base      = str.m_base;
-    m_string    = new char[m_size];
+    m_hash      = str.m_hash;
+    m_string    = buffer(m_count + 1);
     m_allocated = true;
     MemoryBlock::copy(m_string, str.m_string, m_count + 1);
 }
@@ -45,10 +47,11 @@ String::String(char *str, bool copy)
     m_size      = m_count ? m_count + 1 : STRING_DEFAULT_SIZE;
     m_allocated = copy;
     m_base      = Number::Dec;
+    m_hash      = ZERO;
 
     if (copy)
     {
-        m_string = new char[m_size];
+        m_string = buffer(m_count + 1);
         MemoryBlock::copy(m_string, str, m_count + 1);
     }
     else
@@ -61,10 +64,11 @@ String::String(const char *str, bool copy)
     m_size      = m_count ? m_count + 1 : STRING_DEFAULT_SIZE;
     m_allocated = copy;
     m_base      = Number::Dec;
+    m_hash      = ZERO;
 
     if (copy)
     {
-        m_string = new char[m_size];
+        m_string = buffer(m_count + 1);
         MemoryBlock::copy(m_string, str, m_count + 1);
     }
     else
@@ -73,12 +77,13 @@ String::String(const char *str, bool copy)
 
 String::String(int number)
 {
-    m_string    = new char[STRING_DEFAULT_SIZE];
+    m_string    = m_inline;
     m_string[0] = ZERO;
     m_allocated = true;
     m_size      = STRING_DEFAULT_SIZE;
     m_count     = 0;
     m_base      = Number::Dec;
+    m_hash      = ZERO;
 
     set(number);
 }
@@ -87,11 +92,29 @@ String::~String()
 {
     if (m_allocated)
     {
-        delete[] m_string;
+        if (m_string != m_inline)
+            delete[] m_string;
+
         m_allocated = false;
     }
 }
 
+char * String::buffer(Size size)
+{
+    char *buf;
+
+    // Short values fit in the inline buffer
+    if (size <= STRING_DEFAULT_SIZE)
+    {
+        m_size = STRING_DEFAULT_SIZE;
+        return m_inline;
+    }
+    if ((buf = new char[size]) != ZERO)
+        m_size = size;
+
+    return buf;
+}
+
 Size String::size() const
 {
     return m_size;
@@ -124,7 +147,7 @@ Size String::length(const char *str)
 
 bool String::resize(Size size)
 {
-    char *buffer;
+    char *buf;
 
     // Refuse zero-sized Strings.
     if (size == 0)
@@ -132,25 +155,28 @@ bool String::resize(Size size)
 
     // Chop-off String if the current buffer is larger.
     if (m_count >= size)
+    {
         m_count = size - 1;
+        m_hash  = ZERO;
+    }
 
     // Allocate buffer
-    buffer = new char[size];
-    if (!buffer)
+    buf = buffer(size);
+    if (!buf)
         return false;
 
     // Copy the contents of the old buffer, if any.
-    MemoryBlock::copy(buffer, m_string, m_count + 1);
-    buffer[m_count] = ZERO;
+    if (buf != m_string)
+        MemoryBlock::copy(buf, m_string, m_count + 1);
+    buf[m_count] = ZERO;
 
     // Only cleanup the old buffer if it was previously allocated
-    if (m_allocated)
+    if (m_allocated && m_string != m_inline && m_string != buf)
         delete[] m_string;
 
     // Update administration
-    m_string = buffer;
+    m_string = buf;
     m_allocated = true;
-    m_size = size;
     return true;
 }
 
@@ -262,6 +288,22 @@ bool String::equals(const String & str) const
     return compareTo(str.m_string, true, 0) == 0;
 }
 
+Size String::hash() const
+{
+    if (!m_hash)
+    {
+        Size ret = FNV_INIT;
+
+        for (Size i = 0; i < m_count; i++)
+        {
+            ret *= FNV_PRIME;
+            ret ^= m_string[i];
+        }
+        m_hash = ret;
+    }
+    return m_hash;
+}
+
 bool String::match(const char *mask) const
 {
     const char *string = m_string;
@@ -311,16 +353,19 @@ bool String::match(const char *mask) const
 
 String String::substring(Size index, Size size)
 {
-    // Make sure index is within bounds.
+    String str;
+
+    // Make sure index and size are within bounds.
     if (index >= m_count)
         index = m_count;
 
-    // Copy the string from the index.
-    String str(m_string + index);
+    if (!size || size > m_count - index)
+        size = m_count - index;
 
-    // Set a ZERO byte at the right place, if needed.
-    if (size && size < m_count-index)
+    // Copy only the requested characters.
+    if (str.reserve(size))
     {
+        MemoryBlock::copy((void *) str.m_string, m_string + index, size);
         str.m_string[size] = ZERO;
         str.m_count = size;
     }
@@ -348,6 +393,7 @@ String & String::pad(Size length)
         MemoryBlock::set(m_string + idx + curlen + 1, ' ', length-curlen);
         m_count += length-curlen;
         m_string[m_count] = ZERO;
+        m_hash = ZERO;
     }
     return (*this);
 }
@@ -377,6 +423,7 @@ String & String::trim()
     {
         MemoryBlock::copy(m_string, m_string + from, to-from+2);
         m_count = to - from + 1;
+        m_hash = ZERO;
     }
     return (*this);
 }
@@ -389,6 +436,7 @@ String & String::lower()
     for (Size i = 0; i < m_count; i++)
         m_string[i] = Character::lower(m_string[i]);
 
+    m_hash = ZERO;
     return (*this);
 }
 
@@ -400,6 +448,7 @@ String & String::upper()
     for (Size i = 0; i < m_count; i++)
         m_string[i] = Character::upper(m_string[i]);
 
+    m_hash = ZERO;
     return (*this);
 }
 
@@ -417,40 +466,31 @@ List<String> String::split(char delimiter)
 List<String> String::split(const String & delimiter)
 {
     List<String> lst;
-    String copy(m_string);
-    Size from = 0, i = 0;
-
-    // Save copy string pointer
-    char *saved = copy.m_string;
+    Size from = 0, i = 0, j;
 
     // Loop the String.
     while (i < m_count)
     {
         // Find delimiter
-        if (copy.compareTo(delimiter.m_string, true, delimiter.m_count) == 0)
-        {
-            copy.m_string += delimiter.m_count;
+        for (j = 0; j < delimiter.m_count; j++)
+            if (m_string[i + j] != delimiter.m_string[j])
+                break;
 
+        if (delimiter.m_count && j == delimiter.m_count)
+        {
             if (i > from)
-            {
-                String sub = substring(from, i - from);
-                lst.append(sub);
-            }
+                lst.append(substring(from, i - from));
+
             from = i + delimiter.m_count;
             i += delimiter.m_count;
         }
         else
-            copy.m_string++, i++;
+            i++;
     }
     // Append last part, if no more delimiters found
     if (from < m_count)
-    {
-        String sub = substring(from);
-        lst.append(sub);
-    }
+        lst.append(substring(from));
 
-    // Restore saved
-    copy.m_string = saved;
     return lst;
 }
 
@@ -600,7 +640,10 @@ Size String::setUnsigned(ulong number, Number::Base base, char *string, bool sig
     }
     // Update String administration, if needed.
     if (!string)
+    {
         m_count = written;
+        m_hash  = ZERO;
+    }
 
     return written;
 }
@@ -614,18 +657,20 @@ void String::operator = (const char *s)
         MemoryBlock::copy(m_string, s, len + 1);
         m_count = len;
         m_string[m_count] = ZERO;
+        m_hash = ZERO;
     }
 }
 
 void String::operator = (const String & str)
 {
-    Size len = length(str.m_string);
+    Size len = str.m_count;
 
     if (reserve(len))
     {
         MemoryBlock::copy(m_string, str.m_string, len + 1);
         m_count = len;
         m_string[m_count] = ZERO;
+        m_hash = str.m_hash;
     }
 }
 
@@ -646,6 +691,8 @@ const char * String::operator * () const
 
 char * String::operator * ()
 {
+    // The caller may modify the value
+    m_hash = ZERO;
     return m_string;
 }
 
@@ -658,6 +705,7 @@ String & String::operator << (const char *str)
         MemoryBlock::copy(m_string + m_count, str, len + 1);
         m_count += len;
         m_string[m_count] = ZERO;
+        m_hash = ZERO;
     }
     return (*this);
 }
@@ -671,24 +719,30 @@ String & String::operator << (const String & str)
 String & String::operator << (int number)
 {
     if (reserve(m_count + 16))
+    {
         m_count += set(number, m_base, m_string + m_count);
-
+        m_hash = ZERO;
+    }
     return (*this);
 }
 
 String & String::operator << (unsigned int number)
 {
     if (reserve(m_count + 16))
+    {
         m_count += setUnsigned(number, m_base, m_string + m_count);
-
+        m_hash = ZERO;
+    }
     return (*this);
 }
 
 String & String::operator << (void *ptr)
 {
     if (reserve(m_count + 16))
+    {
         m_count += setUnsigned((unsigned long) ptr, Number::Hex, m_string + m_count);
-
+        m_hash = ZERO;
+    }
     return (*this);
 }
 
@@ -32,11 +32,19 @@
  * @{
  */
 
-/** Default maximum length of a String's value. */
-#define STRING_DEFAULT_SIZE 64
+/**
+ * Size of the String's inline buffer.
+ *
+ * Values shorter than this are stored inside the String itself
+ * and need no heap allocation.
+ */
+#define STRING_DEFAULT_SIZE 32
 
 /**
  * Abstraction of strings.
+ *
+ * Short values are kept in an inline buffer. Constant character
+ * strings are referenced without copying until the String is modified.
  */
 class String : public Sequence<char>
 {
@@ -48,7 +56,7 @@ class String : public Sequence<char>
     /**
      * Default constructor.
      *
-     * Constructs an empty string with the default size.
+     * Constructs an empty string using the inline buffer.
      */
     String();
 
@@ -265,6 +273,15 @@ class String : public Sequence<char>
      */
     virtual bool equals(const String &str) const;
 
+    /**
+     * Compute a hash of the String value.
+     *
+     * The hash is cached until the String is modified.
+     *
+     * @return FNV hash of the String characters.
+     */
+    Size hash() const;
+
     /**
      * Matches the String against a mask.
      *
@@ -278,7 +295,8 @@ class String : public Sequence<char>
      * Returns a new String that contains a copy of this String.
      *
      * This function copies the input starting from index (inclusive),
-     * and copies at most size characters.
+     * and copies at most size characters. Substrings which fit
+     * the inline buffer need no heap allocation.
      *
      * @param index The begin index to create the substring of.
      * @param size The maximum size of the substring.
@@ -438,6 +456,15 @@ class String : public Sequence<char>
 
   private:
 
+    /**
+     * Get a writable buffer of at least the given size.
+     *
+     * @param size Minimum size of the buffer in bytes.
+     *
+     * @return The inline buffer if large enough, otherwise a new heap buffer.
+     */
+    char * buffer(Size size);
+
     /** Current value of the String. */
     char *m_string;
 
@@ -452,6 +479,12 @@ class String : public Sequence<char>
 
     /** Number format to use for convertions. */
     Number::Base m_base;
+
+    /** Cached hash of the value, or ZERO if not yet computed. */
+    mutable Size m_hash;
+
+    /** Inline buffer for short values. */
+    char m_inline[STRING_DEFAULT_SIZE];
 };
 
 /**
@@ -71,7 +71,7 @@ template <class T> class Vector : public Sequence<T>
         m_count = a.m_count;
         m_array = new T[m_size];
 
-        for (Size i = 0; i < m_size; i++)
+        for (Size i = 0; i < m_count; i++)
             m_array[i] = a.m_array[i];
     }
 
@@ -92,9 +92,8 @@ template <class T> class Vector : public Sequence<T>
      */
     virtual int insert(const T & item)
     {
-        if (m_count == m_size)
-            if (!resize(m_size*2))
-                return -1;
+        if (!reserve(m_count + 1))
+            return -1;
 
         m_array[m_count++] = item;
         return m_count-1;
@@ -113,13 +112,8 @@ template <class T> class Vector : public Sequence<T>
     virtual bool insert(Size position, const T & item)
     {
         // Resize the vector if needed
-        if (position >= m_size)
-        {
-            Size increase = position > (m_size * 2) ? position : m_size * 2;
-
-            if (!resize(m_size+increase))
-                return false;
-        }
+        if (!reserve(position + 1))
+            return false;
         // Update the item count if needed
         if (position >= m_count)
             m_count += (position+1) - m_count;
@@ -219,7 +213,11 @@ template <class T> class Vector : public Sequence<T>
     /**
      * Resize the Vector.
      *
-     * @param increase Size to add to the Vector.
+     * Items beyond the new size are dropped.
+     *
+     * @param size New size of the Vector.
+     *
+     * @return True if resized successfully, false otherwise.
      */
     virtual bool resize(Size size)
     {
@@ -229,8 +227,12 @@ template <class T> class Vector : public Sequence<T>
         if (!arr)
             return false;
 
-        // Copy the old array in the new one
-        for (Size i = 0; i < m_size; i++)
+        // Chop-off items if the new array is smaller
+        if (m_count > size)
+            m_count = size;
+
+        // Copy only the used items in the new one
+        for (Size i = 0; i < m_count; i++)
         {
             arr[i] = m_array[i];
         }
@@ -241,6 +243,36 @@ template <class T> class Vector : public Sequence<T>
         return true;
     }
 
+    /**
+     * Make sure at least the given number of items fits.
+     *
+     * Grows by at least a factor of two, to keep appending cheap.
+     *
+     * @param size Number of items to reserve.
+     *
+     * @return True if enough space is available, false otherwise.
+     */
+    virtual bool reserve(Size size)
+    {
+        if (size <= m_size)
+            return true;
+
+        return resize(size > m_size * 2 ? size : m_size * 2);
+    }
+
+    /**
+     * Shrink the Vector to the number of items.
+     *
+     * @return New size of the Vector.
+     */
+    virtual Size squeeze()
+    {
+        if (m_count && m_count < m_size)
+            resize(m_count);
+
+        return m_size;
+    }
+
   private:
 
     /** The actual array where the data is stored. */
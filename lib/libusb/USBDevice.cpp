@@ -388,6 +388,7 @@ Error USBDevice::beginTransfer(
         fs.type   = ChannelMessage::Request;
         fs.action = WriteFile;
         fs.path   = fd->path;
+        fs.handle = fd->handle;
         fs.buffer = (char *) msg;
         fs.size   = sizeof(*msg);
         fs.offset = (Size) buffer;
@@ -17,6 +17,7 @@
 
 #include <FreeNOS/System.h>
 #include <ExecutableFormat.h>
+#include <MemoryBlock.h>
 #include "CoreServer.h"
 #include <stdio.h>
 #include <string.h>
@@ -49,6 +50,7 @@ CoreServer::CoreServer()
     m_toSlave = ZERO;
     m_fromSlave = ZERO;
 #endif
+    m_coreLoad = ZERO;
 
     // Register IPC handlers
     addIPCHandler(ReadFile,  &CoreServer::getCoreCount);
@@ -84,7 +86,6 @@ int CoreServer::runCore()
 
 void CoreServer::createProcess(FileSystemMessage *msg)
 {
-    char cmd[128];
     Memory::Range range;
 
     if (m_info.coreId == 0)
@@ -97,6 +98,18 @@ void CoreServer::createProcess(FileSystemMessage *msg)
         VMCtl(msg->from, LookupVirtual, &range);
         msg->path = (char *) range.phys;
 
+        // Place the process on the least busy core, if requested
+        if (msg->size == COREINFO_ANY_CORE)
+            msg->size = findIdleCore();
+
+        if (msg->size == 0)
+        {
+            DEBUG("creating program at phys " << (void *) msg->buffer << " on core0");
+            msg->result = spawnProcess(msg) >= 0 ? ESUCCESS : EIO;
+            ChannelClient::instance->syncSendTo(msg, msg->from);
+            return;
+        }
+
         if (sendToSlave(msg->size, msg) != Success)
         {
             ERROR("failed to write channel on core"<<msg->size);
@@ -118,15 +131,7 @@ void CoreServer::createProcess(FileSystemMessage *msg)
     }
     else
     {
-        VMCopy(SELF, API::ReadPhys, (Address) cmd, (Address) msg->path, sizeof(cmd));
-
-        range.phys   = (Address) msg->buffer;
-        range.virt   = 0;
-        range.access = Memory::Readable | Memory::User;
-        range.size   = msg->offset;
-        VMCtl(SELF, Map, &range);
-
-        pid_t pid = spawn(range.virt, msg->offset, cmd);
+        int pid = spawnProcess(msg);
         int status;
 
         // reply to master before calling waitpid()
@@ -138,6 +143,50 @@ void CoreServer::createProcess(FileSystemMessage *msg)
     }
 }
 
+int CoreServer::spawnProcess(FileSystemMessage *msg)
+{
+    char cmd[128];
+    Memory::Range range;
+
+    VMCopy(SELF, API::ReadPhys, (Address) cmd, (Address) msg->path, sizeof(cmd));
+
+    range.phys   = (Address) msg->buffer;
+    range.virt   = 0;
+    range.access = Memory::Readable | Memory::User;
+    range.size   = msg->offset;
+    VMCtl(SELF, Map, &range);
+
+    int pid = spawn(range.virt, msg->offset, cmd);
+
+    // The program is copied into the new process
+    VMCtl(SELF, UnMap, &range);
+    return pid;
+}
+
+uint CoreServer::findIdleCore()
+{
+    SystemInformation info;
+    Size load = info.runnable;
+    uint coreId = 0;
+
+    if (!m_coreLoad)
+        return coreId;
+
+    for (Size i = 1; i < m_coreLoad->size(); i++)
+    {
+        const CoreLoad *core = m_coreLoad->get(i);
+
+        if (core && core->runnable < load)
+        {
+            load = core->runnable;
+            coreId = i;
+        }
+    }
+
+    DEBUG("core" << coreId << " has " << load << " runnable processes");
+    return coreId;
+}
+
 void CoreServer::getCoreCount(FileSystemMessage *msg)
 {
     DEBUG("");
@@ -293,10 +342,14 @@ CoreServer::Result CoreServer::bootCore(uint coreId, CoreInfo *info,
 #pragma GCC diagnostic ignored "-Wsign-compare"
         API::Result r = VMCopy(SELF, API::Write, (Address) regions[i].data,
                                range.virt,
-                               regions[i].size);
-        if ((Size)r != regions[i].size)
+                               regions[i].dataSize);
+        if ((Size)r != regions[i].dataSize)
             return MemoryError;
 
+        // Zero-fill the remainder
+        MemoryBlock::set((void *) (range.virt + regions[i].dataSize), 0,
+                         regions[i].size - regions[i].dataSize);
+
         // Unmap the target kernel's memory
         if (VMCtl(SELF, UnMap, &range) != API::Success)
         {
@@ -400,7 +453,7 @@ CoreServer::Result CoreServer::discover()
             info->bootImageSize    = sysInfo.bootImageSize;
             info->coreChannelAddress = info->bootImageAddress + info->bootImageSize;
             info->coreChannelAddress += PAGESIZE - (info->bootImageSize % PAGESIZE);
-            info->coreChannelSize    = PAGESIZE * 4;
+            info->coreChannelSize    = COREINFO_LOAD_OFFSET + PAGESIZE;
             clearPages(info->coreChannelAddress, info->coreChannelSize);
 
             m_kernel->entry(&info->kernelEntry);
@@ -463,6 +516,7 @@ CoreServer::Result CoreServer::setupChannels()
 
         m_toSlave    = new Index<MemoryChannel>(numCores);
         m_fromSlave  = new Index<MemoryChannel>(numCores);
+        m_coreLoad   = new Index<CoreLoad>(numCores);
 
         for (Size i = 1; i < numCores; i++)
         {
@@ -480,6 +534,20 @@ CoreServer::Result CoreServer::setupChannels()
             ch->setPhysical(coreInfo->coreChannelAddress,
                             coreInfo->coreChannelAddress + PAGESIZE);
             m_fromSlave->insert(i, *ch);
+
+            // Map the load which the kernel of the core publishes
+            Memory::Range range;
+            range.phys   = coreInfo->coreChannelAddress + COREINFO_LOAD_OFFSET;
+            range.virt   = ZERO;
+            range.size   = PAGESIZE;
+            range.access = Memory::User | Memory::Readable;
+
+            if (VMCtl(SELF, Map, &range) != API::Success)
+            {
+                ERROR("failed to map load page of core" << i);
+                continue;
+            }
+            m_coreLoad->insert(i, *(CoreLoad *) range.virt);
         }
     }
     else
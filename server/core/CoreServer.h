@@ -182,6 +182,22 @@ class CoreServer : public ChannelServer<CoreServer, FileSystemMessage>
      */
     void createProcess(FileSystemMessage *msg);
 
+    /**
+     * Spawn a program which is stored in physical memory on the local core
+     *
+     * @param msg FileSystemMessage with physical program and command addresses
+     *
+     * @return Process ID of the new process or negative on failure
+     */
+    int spawnProcess(FileSystemMessage *msg);
+
+    /**
+     * Find the processor core with the least processes ready to run
+     *
+     * @return Core identifier
+     */
+    uint findIdleCore();
+
     /**
      * Receive message from master
      *
@@ -244,6 +260,9 @@ class CoreServer : public ChannelServer<CoreServer, FileSystemMessage>
 
     MemoryChannel *m_toMaster;
     MemoryChannel *m_fromMaster;
+
+    /** Published load of each slave core */
+    Index<CoreLoad> *m_coreLoad;
 };
 
 /**
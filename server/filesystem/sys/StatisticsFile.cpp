@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2019 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include "StatisticsFile.h"
+
+StatisticsFile::StatisticsFile(StatisticsFile::Counter counter)
+    : File(RegularFile)
+    , m_counter(counter)
+{
+    m_access = OwnerR;
+}
+
+StatisticsFile::~StatisticsFile()
+{
+}
+
+Error StatisticsFile::read(IOBuffer & buffer, Size size, Size offset)
+{
+    char text[24], *ptr = text + sizeof(text);
+    u64 val = value();
+
+    // Format the value as decimal text, from the last digit backwards
+    *--ptr = '\n';
+    do
+    {
+        *--ptr = '0' + (val % 10);
+        val /= 10;
+    }
+    while (val);
+
+    const Size length = (text + sizeof(text)) - ptr;
+    m_size = length;
+
+    // Bounds checking
+    if (offset >= length)
+        return 0;
+
+    // How much bytes to copy?
+    Size bytes = length - offset > size ? size : length - offset;
+
+    // Copy the buffers
+    return buffer.write(ptr + offset, bytes);
+}
+
+u64 StatisticsFile::value() const
+{
+    SystemInformation info;
+
+    switch (m_counter)
+    {
+        case ContextSwitches: return info.stats.contextSwitches;
+        case ScheduleCycles:  return info.stats.scheduleCycles;
+        case ChannelFull:     return info.stats.channelFull;
+        case CopyPages:       return info.stats.copyPages;
+        case CopyCycles:      return info.stats.copyCycles;
+        case PagesUsed:       return (info.memorySize - info.memoryAvail) / PAGESIZE;
+    }
+
+    return 0;
+}
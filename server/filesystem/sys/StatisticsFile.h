@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2019 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FILESYSTEM_SYS_STATISTICSFILE_H
+#define __FILESYSTEM_SYS_STATISTICSFILE_H
+
+#include <File.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup sysfs
+ * @{
+ */
+
+/**
+ * Exports a single kernel statistics counter as a decimal text value.
+ *
+ * The value is retrieved with SystemInfo() on every read, thus
+ * it always reflects the current counters of the local core.
+ *
+ * @see KernelStatistics
+ */
+class StatisticsFile : public File
+{
+  public:
+
+    /**
+     * Available counters.
+     */
+    enum Counter
+    {
+        ContextSwitches,
+        ScheduleCycles,
+        ChannelFull,
+        CopyPages,
+        CopyCycles,
+        PagesUsed
+    };
+
+    /**
+     * Constructor function.
+     *
+     * @param counter Counter to export.
+     */
+    StatisticsFile(Counter counter);
+
+    /**
+     * Destructor function.
+     */
+    virtual ~StatisticsFile();
+
+    /**
+     * @brief Read bytes from the file.
+     *
+     * @param buffer Input/Output buffer to output bytes to.
+     * @param size Number of bytes to read, at maximum.
+     * @param offset Offset inside the file to start reading.
+     *
+     * @return Number of bytes read on success, Error on failure.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+  private:
+
+    /**
+     * Retrieve the current value of the counter.
+     *
+     * @return Counter value.
+     */
+    u64 value() const;
+
+  private:
+
+    /** Counter exported by this file. */
+    const Counter m_counter;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __FILESYSTEM_SYS_STATISTICSFILE_H */
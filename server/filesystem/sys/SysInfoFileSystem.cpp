@@ -20,6 +20,7 @@
 #include "SysInfoFileSystem.h"
 #include "MountsFile.h"
 #include "MountWaitFile.h"
+#include "StatisticsFile.h"
 
 SysInfoFileSystem::SysInfoFileSystem(const char *path)
     : FileSystem(path)
@@ -27,4 +28,13 @@ SysInfoFileSystem::SysInfoFileSystem(const char *path)
     setRoot(new Directory);
     registerFile(new MountsFile, "mounts");
     registerFile(new MountWaitFile, "mountwait");
+
+    // Kernel statistics counters
+    registerFile(new Directory, "stats");
+    registerFile(new StatisticsFile(StatisticsFile::ContextSwitches), "stats/contextSwitches");
+    registerFile(new StatisticsFile(StatisticsFile::ScheduleCycles), "stats/scheduleCycles");
+    registerFile(new StatisticsFile(StatisticsFile::ChannelFull), "stats/channelFull");
+    registerFile(new StatisticsFile(StatisticsFile::CopyPages), "stats/copyPages");
+    registerFile(new StatisticsFile(StatisticsFile::CopyCycles), "stats/copyCycles");
+    registerFile(new StatisticsFile(StatisticsFile::PagesUsed), "stats/pagesUsed");
 }
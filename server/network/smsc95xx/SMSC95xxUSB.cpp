@@ -19,12 +19,12 @@
 #include <Log.h>
 #include <Runtime.h>
 #include <Callback.h>
+#include <MemoryBlock.h>
 #include <NetworkServer.h>
 #include "SMSC95xx.h"
 #include "SMSC95xxUSB.h"
 
 #define SMSC9512_HS_USB_PKT_SIZE 512
-#define SMSC9512_DEFAULT_HS_BURST_CAP_SIZE (16 * 1024 + 5 * SMSC9512_HS_USB_PKT_SIZE)
 
 SMSC95xxUSB::SMSC95xxUSB(u8 deviceId,
                          const char *usbPath,
@@ -34,8 +34,8 @@ SMSC95xxUSB::SMSC95xxUSB(u8 deviceId,
 {
     DEBUG("");
 
-    m_rxPacket      = 0;
-    m_txPacket      = 0;
+    m_rxBuffer      = ZERO;
+    m_txCount       = 0;
     m_value         = new u32;
     m_packetSize    = 1500 + TransmitCommandSize;
     m_readFinished  = new Callback<SMSC95xxUSB, FileSystemMessage>(this, &SMSC95xxUSB::readFinished);
@@ -43,6 +43,9 @@ SMSC95xxUSB::SMSC95xxUSB(u8 deviceId,
     m_server        = server;
     m_smsc          = smsc;
 
+    for (Size i = 0; i < TransmitTransfers; i++)
+        m_txPackets[i] = ZERO;
+
     // Set packet header size
     m_smsc->getTransmitQueue()->setHeaderSize(TransmitCommandSize);
 }
@@ -78,37 +81,46 @@ Error SMSC95xxUSB::initialize()
 
     // Enable RX/TX bits on hardware
     write(HardwareConfig, read(HardwareConfig) | MultipleEther | BulkIn | BCE);
-    write(BurstCap, SMSC9512_DEFAULT_HS_BURST_CAP_SIZE / SMSC9512_HS_USB_PKT_SIZE);
+    write(BurstCap, ReceiveBufferSize / SMSC9512_HS_USB_PKT_SIZE);
     write(MACControl, read(MACControl) | MACTransmit | MACReceive);
     write(TransmitConfig, TransmitOn);
 
-    // Begin packet receive transfer
-    readStart();
+    // Allocate physically contiguous memory for the receive transfers
+    Memory::Range range;
+    range.phys   = 0;
+    range.virt   = 0;
+    range.size   = ReceiveTransfers * ReceiveBufferSize;
+    range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (range.size % PAGESIZE)
+        range.size += PAGESIZE - (range.size % PAGESIZE);
+
+    if (VMCtl(SELF, Map, &range) != API::Success)
+    {
+        ERROR("failed to allocate receive buffers");
+        return EIO;
+    }
+    m_rxBuffer = (u8 *) range.virt;
+
+    // Begin packet receive transfers
+    for (Size i = 0; i < ReceiveTransfers; i++)
+        readStart(i);
 
     // Done
     return ESUCCESS;
 }
 
-void SMSC95xxUSB::readStart()
+void SMSC95xxUSB::readStart(Size index)
 {
-    Size rxSize = m_packetSize;
+    DEBUG("index = " << index);
 
-    DEBUG("");
-
-    // Get receive packet buffer
-    m_rxPacket = m_smsc->getReceiveQueue()->get();
-    if (!m_rxPacket)
-    {
-        ERROR("no free receive packet buffer available");
-        return;
-    }
     // Begin USB transfer
     Error err = beginTransfer(
         USBTransfer::Bulk,
         USBTransfer::In,
         m_endpoints[0].endpointAddress & 0xf,
-        m_rxPacket->data,
-        rxSize,
+        m_rxBuffer + (index * ReceiveBufferSize),
+        ReceiveBufferSize,
         m_endpoints[0].maxPacketSize,
         m_readFinished
     );
@@ -120,87 +132,145 @@ void SMSC95xxUSB::readFinished(FileSystemMessage *message)
 {
     DEBUG("identifier = " << message->identifier << " result = " << (int)message->result);
 
-    if (!m_rxPacket)
-    {
-        ERROR("unexpected readFinish with no receive packet buffer");
-        return;
-    }
-
-    // Extract packet
     // Offset field contains virtual address of input data buffer
     u8 *data = (u8 *) message->offset;
-    u32 receiveCmd = data[0] | data[1] << 8 | data[2] << 16 | data[3] << 24;
-    Size frameLength = (receiveCmd & RxCommandFrameLength) >> 16;
+    const Size index = (data - m_rxBuffer) / ReceiveBufferSize;
+    const Size length = ((USBMessage *) message->buffer)->size;
 
-    if (frameLength == 0 || frameLength > m_packetSize)
+    if (data < m_rxBuffer || index >= ReceiveTransfers)
     {
-        ERROR("invalid framelength: " << frameLength);
+        ERROR("unexpected readFinish for unknown receive buffer");
+        return;
     }
-    else
-    {
-        DEBUG("packet is " << frameLength << " bytes long");
 
-        // Publish the packet to our parent
-        m_rxPacket->size = frameLength;
-        m_smsc->process(m_rxPacket, ReceiveCommandSize);
-
-        // Release the packet buffer
-        m_smsc->getReceiveQueue()->release(m_rxPacket);
-        m_rxPacket = 0;
+    // Extract all frames. Each frame is prefixed with a
+    // receive command word and padded to a 32-bit boundary.
+    for (Size offset = 0; message->result >= 0 && offset + ReceiveCommandSize <= length;)
+    {
+        u32 receiveCmd = data[offset] | data[offset+1] << 8 | data[offset+2] << 16 | data[offset+3] << 24;
+        Size frameLength = (receiveCmd & RxCommandFrameLength) >> 16;
+
+        if (frameLength == 0 || offset + ReceiveCommandSize + frameLength > length)
+        {
+            ERROR("invalid framelength: " << frameLength);
+            break;
+        }
+
+        if (receiveCmd & RxCommandErrorSummary)
+        {
+            DEBUG("dropped frame with receive error: " << receiveCmd);
+        }
+        else
+            receiveFrame(data + offset + ReceiveCommandSize, frameLength);
+
+        offset += (ReceiveCommandSize + frameLength + 3) & ~3;
     }
 
     // Release USB transfer
     finishTransfer(message);
 
     // Restart read transfer
-    readStart();
+    readStart(index);
 }
 
-void SMSC95xxUSB::writeStart()
+void SMSC95xxUSB::receiveFrame(const u8 *frame, Size length)
 {
-    DEBUG("");
+    Size size = length > Ethernet::CRCSize ? length - Ethernet::CRCSize : 0;
+
+    DEBUG("packet is " << size << " bytes long");
 
-    if (m_txPacket)
+    if (size > m_smsc->getMaximumPacketSize())
     {
-        ERROR("transmit already in progress");
+        ERROR("frame too large: " << size);
         return;
     }
 
-    m_txPacket = m_smsc->getTransmitQueue()->pop();
-    if (!m_txPacket)
+    // Get receive packet buffer
+    NetworkQueue::Packet *pkt = m_smsc->getReceiveQueue()->get();
+    if (!pkt)
     {
-        DEBUG("no transmit data packet available");
+        ERROR("no free receive packet buffer available");
         return;
     }
 
-    // Flush L1 cache
-    VMCtl(SELF, CacheClean, 0);
+    // The transfer buffer holds a burst of frames and is resubmitted as soon
+    // as it is parsed. Copying each frame once into a receive packet keeps the
+    // bulk-in transfer running while sockets still hold on to earlier frames.
+    MemoryBlock::copy(pkt->data, frame, size);
+    pkt->size = size;
 
-    // Start bulk transfer
-    beginTransfer(
-        USBTransfer::Bulk,
-        USBTransfer::Out,
-        m_endpoints[1].endpointAddress & 0xf,
-        m_txPacket->data,
-        m_txPacket->size,
-        m_endpoints[1].maxPacketSize,
-        m_writeFinished
-    );
+    // Publish the packet to our parent
+    m_smsc->process(pkt);
+
+    // Release the packet buffer
+    m_smsc->getReceiveQueue()->release(pkt);
+}
+
+void SMSC95xxUSB::writeStart()
+{
+    NetworkQueue *queue = m_smsc->getTransmitQueue();
+    bool flushed = false;
+
+    DEBUG("");
+
+    while (m_txCount < TransmitTransfers && queue->count())
+    {
+        NetworkQueue::Packet *pkt = queue->pop();
+        Size slot = 0;
+
+        // Flush L1 cache
+        if (!flushed)
+        {
+            VMCtl(SELF, CacheClean, 0);
+            flushed = true;
+        }
+
+        while (m_txPackets[slot])
+            slot++;
+
+        // Start bulk transfer
+        Error err = beginTransfer(
+            USBTransfer::Bulk,
+            USBTransfer::Out,
+            m_endpoints[1].endpointAddress & 0xf,
+            pkt->data,
+            pkt->size,
+            m_endpoints[1].maxPacketSize,
+            m_writeFinished
+        );
+        if (err != ESUCCESS)
+        {
+            ERROR("failed to submit packet transmit request");
+            queue->release(pkt);
+            break;
+        }
+
+        m_txPackets[slot] = pkt;
+        m_txCount++;
+    }
 }
 
 void SMSC95xxUSB::writeFinished(FileSystemMessage *message)
 {
     DEBUG("identifier = " << message->identifier << " result = " << (int)message->result);
 
-    if (!m_txPacket)
+    // Offset field contains virtual address of output data buffer
+    u8 *data = (u8 *) message->offset;
+    Size slot = 0;
+
+    while (slot < TransmitTransfers && (!m_txPackets[slot] || m_txPackets[slot]->data != data))
+        slot++;
+
+    if (slot == TransmitTransfers)
     {
         ERROR("no transmit packet in progress");
         return;
     }
 
     // Clean transmit packet
-    m_smsc->getTransmitQueue()->release(m_txPacket);
-    m_txPacket = 0;
+    m_smsc->getTransmitQueue()->release(m_txPackets[slot]);
+    m_txPackets[slot] = ZERO;
+    m_txCount--;
 
     // Release USB transfer
     finishTransfer(message);
@@ -240,9 +310,8 @@ Error SMSC95xxUSB::transmit(NetworkQueue::Packet *pkt)
     // Submit packet for transmit
     m_smsc->getTransmitQueue()->push(pkt);
 
-    // begin write, if not already doing
-    if (!m_txPacket)
-        writeStart();
+    // Begin write, if a transfer slot is available
+    writeStart();
 
     // Packet in transmission
     return pkt->size;
@@ -35,6 +35,10 @@ class SMSC95xx;
 
 /**
  * SMSC95xx USB-based Ethernet controller.
+ *
+ * Multiple bulk-in and bulk-out transfers are kept in flight. Each bulk-in
+ * transfer is sized to the burst capability of the device and may return
+ * multiple Ethernet frames, which are split into separate packets.
  */
 class SMSC95xxUSB : public USBDevice
 {
@@ -164,6 +168,15 @@ class SMSC95xxUSB : public USBDevice
     /** Receive Command Word size. */
     static const Size ReceiveCommandSize = 4;
 
+    /** Number of bulk-in transfers in flight. */
+    static const Size ReceiveTransfers = 4;
+
+    /** Number of bulk-out transfers in flight. */
+    static const Size TransmitTransfers = 4;
+
+    /** Size of the buffer for each bulk-in transfer, which must fit the BurstCap. */
+    static const Size ReceiveBufferSize = 16 * 1024 + 5 * 512;
+
     /**
      * Constructor
      */
@@ -193,10 +206,38 @@ class SMSC95xxUSB : public USBDevice
 
   private:
 
-    void readStart();
+    /**
+     * Start a bulk-in transfer.
+     *
+     * @param index Index of the receive buffer to use.
+     */
+    void readStart(Size index);
+
+    /**
+     * Called when a bulk-in transfer completes.
+     *
+     * @param message Transfer completion message.
+     */
     void readFinished(FileSystemMessage *message);
 
+    /**
+     * Publish a single received frame to the network stack.
+     *
+     * @param frame Start of the Ethernet frame
+     * @param length Length of the frame in bytes, including CRC
+     */
+    void receiveFrame(const u8 *frame, Size length);
+
+    /**
+     * Start bulk-out transfers for pending transmit packets.
+     */
     void writeStart();
+
+    /**
+     * Called when a bulk-out transfer completes.
+     *
+     * @param message Transfer completion message.
+     */
     void writeFinished(FileSystemMessage *message);
 
     /**
@@ -233,8 +274,15 @@ class SMSC95xxUSB : public USBDevice
     Size m_packetSize;
     NetworkServer *m_server;
     SMSC95xx *m_smsc;
-    NetworkQueue::Packet *m_rxPacket;
-    NetworkQueue::Packet *m_txPacket;
+
+    /** Physically contiguous buffers for bulk-in transfers */
+    u8 *m_rxBuffer;
+
+    /** Packets in bulk-out transfer, or ZERO if the slot is unused */
+    NetworkQueue::Packet *m_txPackets[TransmitTransfers];
+
+    /** Number of bulk-out transfers in flight */
+    Size m_txCount;
 };
 
 /**
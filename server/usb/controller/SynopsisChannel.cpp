@@ -45,6 +45,11 @@ const FileSystemMessage * SynopsisChannel::getMessage() const
     return m_msg;
 }
 
+const USBMessage * SynopsisChannel::getUSBMessage() const
+{
+    return m_usb;
+}
+
 SynopsisChannel::Result SynopsisChannel::initialize()
 {
     // Clear and mask all interrupts
@@ -164,6 +164,13 @@ class SynopsisChannel
      */
     const FileSystemMessage * getMessage() const;
 
+    /**
+     * Get USB message.
+     *
+     * @return USBMessage pointer or ZERO if not transferring.
+     */
+    const USBMessage * getUSBMessage() const;
+
     /**
      * Get state.
      *
@@ -146,7 +146,16 @@ void SynopsisController::interruptHandler(Size vector)
         for (Size i = 0; i < ChannelCount; i++)
         {
             if (channelInt & (1 << i))
+            {
+                const USBMessage *usb = m_channels[i].getUSBMessage();
+
                 m_channels[i].interrupt();
+
+                // Remember the next packet id of the endpoint
+                if (usb && usb->type != USBTransfer::Control &&
+                    usb->state == USBMessage::Success)
+                    m_packetIds.insert(getEndpointKey(usb), usb->packetId);
+            }
         }
     }
     // Re-enable IRQ in the kernel
@@ -216,6 +225,27 @@ SynopsisChannel * SynopsisController::getChannel(const FileSystemMessage *msg,
     return ZERO;
 }
 
+Size SynopsisController::getEndpointKey(const USBMessage *usb) const
+{
+    return (usb->deviceId << 5) | (usb->direction << 4) | (usb->endpointId & 0xf);
+}
+
+bool SynopsisController::isEndpointBusy(const USBMessage *usb) const
+{
+    const Size key = getEndpointKey(usb);
+
+    for (Size i = 0; i < ChannelCount; i++)
+    {
+        const SynopsisChannel *ch = &m_channels[i];
+        const USBMessage *active = ch->getUSBMessage();
+
+        if (ch->getState() != SynopsisChannel::Idle && active &&
+            active->type != USBTransfer::Control && getEndpointKey(active) == key)
+            return true;
+    }
+    return false;
+}
+
 Error SynopsisController::transfer(const FileSystemMessage *msg,
                                    USBMessage *usb)
 {
@@ -231,6 +261,18 @@ Error SynopsisController::transfer(const FileSystemMessage *msg,
         case USBMessage::Data:
         case USBMessage::Status:
 
+            // Start queued transfers on an endpoint one at a time,
+            // continuing with the packet id of the previous transfer.
+            if (ch->getState() == SynopsisChannel::Idle && usb->type != USBTransfer::Control)
+            {
+                if (isEndpointBusy(usb))
+                    return EAGAIN;
+
+                const u8 *packetId = m_packetIds.get(getEndpointKey(usb));
+                if (packetId)
+                    usb->packetId = *packetId;
+            }
+
             switch (ch->transfer(msg, usb))
             {
                 case SynopsisChannel::TransferStarted: return EAGAIN;
@@ -21,6 +21,7 @@
 #include <FreeNOS/System.h>
 #include <Types.h>
 #include <Index.h>
+#include <HashTable.h>
 #include <arm/broadcom/BroadcomPower.h>
 #include "USBController.h"
 #include "SynopsisChannel.h"
@@ -179,6 +180,24 @@ class SynopsisController : public USBController
     SynopsisChannel * getChannel(const FileSystemMessage *msg,
                                  USBMessage *usb);
 
+    /**
+     * Get the key identifying the endpoint of a transfer.
+     *
+     * @param usb USB message
+     *
+     * @return Endpoint key
+     */
+    Size getEndpointKey(const USBMessage *usb) const;
+
+    /**
+     * Check if a channel is transferring on the endpoint of a message.
+     *
+     * @param usb USB message
+     *
+     * @return True if the endpoint is busy, false otherwise.
+     */
+    bool isEndpointBusy(const USBMessage *usb) const;
+
     /**
      * Interrupt request handler.
      *
@@ -203,6 +222,15 @@ class SynopsisController : public USBController
 
     /** Channels. */
     Index<SynopsisChannel> m_channels;
+
+    /**
+     * Next packet id of each non-control endpoint.
+     *
+     * Clients may queue multiple transfers for the same endpoint. These are
+     * transferred one at a time and the packet id (data toggle) of each
+     * completed transfer is passed on to the next.
+     */
+    HashTable<Size, u8> m_packetIds;
 };
 
 /**
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <BubbleAllocator.h>
+#include <PoolAllocator.h>
+
+/** Memory for the parent allocator of each test. */
+static u8 poolMemory[PAGESIZE * 64];
+
+TestCase(PoolAllocate)
+{
+    BubbleAllocator bubble((Address) poolMemory, sizeof(poolMemory));
+    PoolAllocator pool;
+    Allocator::Arguments args;
+    Address addrs[16];
+    pool.setParent(&bubble);
+
+    // Allocate blocks of increasing sizes
+    for (Size i = 0; i < 16; i++)
+    {
+        args.address   = 0;
+        args.alignment = 0;
+        args.size      = 1 << i;
+        testAssert(pool.allocate(args) == Allocator::Success);
+        testAssert(args.address != ZERO);
+        addrs[i] = args.address;
+
+        // The pool header is found by masking the block address
+        MemoryPool *p = (MemoryPool *) (args.address & ~((Address) POOL_SLAB_SIZE - 1));
+        testAssert(p->size >= args.size);
+        testAssert(args.address >= p->addr);
+        testAssert(args.address < p->addr + (p->count * p->size));
+    }
+    // Release all blocks
+    for (Size i = 0; i < 16; i++)
+        testAssert(pool.release(addrs[i]) == Allocator::Success);
+
+    // Double release is rejected
+    testAssert(pool.release(addrs[0]) == Allocator::InvalidAddress);
+    return OK;
+}
+
+TestCase(PoolReleaseUnknown)
+{
+    BubbleAllocator bubble((Address) poolMemory, sizeof(poolMemory));
+    PoolAllocator pool;
+    Allocator::Arguments args;
+    pool.setParent(&bubble);
+
+    args.address   = 0;
+    args.alignment = 0;
+    args.size      = 32;
+    testAssert(pool.allocate(args) == Allocator::Success);
+
+    // Addresses outside of the pools or not at a block boundary are rejected
+    testAssert(pool.release((Address) &args) == Allocator::InvalidAddress);
+    testAssert(pool.release(args.address + 1) == Allocator::InvalidAddress);
+    testAssert(pool.release(args.address) == Allocator::Success);
+    return OK;
+}
+
+TestCase(PoolReuse)
+{
+    BubbleAllocator bubble((Address) poolMemory, sizeof(poolMemory));
+    PoolAllocator pool;
+    Allocator::Arguments args;
+    Address first = 0, last = 0;
+    pool.setParent(&bubble);
+
+    args.alignment = 0;
+    args.size      = 8;
+
+    // Fill the first pool completely
+    testAssert(pool.allocate(args) == Allocator::Success);
+    first = args.address;
+    MemoryPool *p = (MemoryPool *) (first & ~((Address) POOL_SLAB_SIZE - 1));
+
+    for (Size i = 1; i < p->count; i++)
+    {
+        testAssert(pool.allocate(args) == Allocator::Success);
+        testAssert(args.address == first + (i * 8));
+    }
+    testAssert(p->free == 0);
+
+    // The next block comes from a new pool
+    testAssert(pool.allocate(args) == Allocator::Success);
+    last = args.address;
+    testAssert((last & ~((Address) POOL_SLAB_SIZE - 1)) != (Address) p);
+
+    // Releasing a block of a full pool makes it available again
+    testAssert(pool.release(first + 8) == Allocator::Success);
+    testAssert(pool.allocate(args) == Allocator::Success);
+    testAssert(args.address == first + 8);
+    testAssert(pool.release(last) == Allocator::Success);
+    return OK;
+}
+
+/**
+ * Parent allocator which accepts memory back and counts releases.
+ */
+class ReclaimAllocator : public BubbleAllocator
+{
+  public:
+
+    ReclaimAllocator(Address start, Size size)
+        : BubbleAllocator(start, size), released(0)
+    {
+    }
+
+    virtual Result release(Address addr)
+    {
+        released++;
+        return Success;
+    }
+
+    Size released;
+};
+
+TestCase(PoolReclaim)
+{
+    ReclaimAllocator parent((Address) poolMemory, sizeof(poolMemory));
+    PoolAllocator pool;
+    Allocator::Arguments args;
+    Address first, second;
+    pool.setParent(&parent);
+
+    args.alignment = 0;
+    args.size      = 1024;
+
+    // Fill the first pool and start a second one
+    testAssert(pool.allocate(args) == Allocator::Success);
+    first = args.address;
+    MemoryPool *p = (MemoryPool *) (first & ~((Address) POOL_SLAB_SIZE - 1));
+
+    for (Size i = 1; i < p->count; i++)
+        testAssert(pool.allocate(args) == Allocator::Success);
+
+    testAssert(pool.allocate(args) == Allocator::Success);
+    second = args.address;
+    testAssert((second & ~((Address) POOL_SLAB_SIZE - 1)) != (Address) p);
+
+    // Emptying the first pool returns it to the parent
+    for (Size i = 0; i < p->count; i++)
+        testAssert(pool.release(first + (i * 1024)) == Allocator::Success);
+
+    testAssert(parent.released == 1);
+
+    // The last pool with free blocks is kept
+    testAssert(pool.release(second) == Allocator::Success);
+    testAssert(parent.released == 1);
+
+    // Large blocks have a pool of their own and are returned
+    args.size = POOL_SLAB_SIZE * 2;
+    testAssert(pool.allocate(args) == Allocator::Success);
+    first = args.address;
+    testAssert(pool.allocate(args) == Allocator::Success);
+    testAssert(pool.release(first) == Allocator::Success);
+    testAssert(parent.released == 1);
+    testAssert(pool.release(args.address) == Allocator::Success);
+    testAssert(parent.released == 4);
+    return OK;
+}
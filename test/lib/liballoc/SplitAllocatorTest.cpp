@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <SplitAllocator.h>
+
+TestCase(SplitIsLowSmallMemory)
+{
+    Memory::Range low, high;
+
+    // 512MB of RAM, which is less than the kernel low memory window
+    low.phys  = 0;
+    low.size  = 512 * 1024 * 1024;
+    high.phys = 896 * 1024 * 1024;
+    high.size = 0;
+
+    SplitAllocator alloc(low, high);
+
+    testAssert(alloc.isLow(0));
+    testAssert(alloc.isLow(low.size - PAGESIZE));
+
+    // Device memory above the end of RAM is never low memory
+    testAssert(!alloc.isLow(low.size));
+    testAssert(!alloc.isLow(0x20000000));
+    testAssert(!alloc.isLow(high.phys - PAGESIZE));
+    return OK;
+}
+
+TestCase(SplitIsLowLargeMemory)
+{
+    Memory::Range low, high;
+
+    // 1GB of RAM starting at 16MB, with high memory beyond the window
+    low.phys  = 16 * 1024 * 1024;
+    low.size  = 1024 * 1024 * 1024;
+    high.phys = low.phys + (896 * 1024 * 1024);
+    high.size = 0;
+
+    SplitAllocator alloc(low, high);
+
+    testAssert(!alloc.isLow(0));
+    testAssert(alloc.isLow(low.phys));
+    testAssert(alloc.isLow(high.phys - PAGESIZE));
+
+    // Memory past the window is high memory
+    testAssert(!alloc.isLow(high.phys));
+    testAssert(!alloc.isLow(low.phys + low.size - PAGESIZE));
+    return OK;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2019 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <Checksum.h>
+
+/**
+ * Straightforward Internet checksum of a buffer, summing
+ * big endian 16-bit words one at a time.
+ *
+ * @return Checksum value in big endian byte order.
+ */
+static u16 referenceChecksum(const u8 *buffer, Size length)
+{
+    u32 sum = 0;
+
+    for (Size i = 0; i + 1 < length; i += 2)
+        sum += (buffer[i] << 8) | buffer[i + 1];
+
+    if (length & 1)
+        sum += buffer[length - 1] << 8;
+
+    while (sum >> 16)
+        sum = (sum >> 16) + (sum & 0xffff);
+
+    return ~sum & 0xffff;
+}
+
+/**
+ * Convert a checksum as stored in memory to big endian byte order.
+ */
+static u16 storedChecksum(u16 checksum)
+{
+    const u8 *bytes = (const u8 *) &checksum;
+    return (bytes[0] << 8) | bytes[1];
+}
+
+TestCase(ChecksumRFC1071)
+{
+    // Example from RFC 1071, section 3
+    u8 buffer[] = { 0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7 };
+
+    testAssert(storedChecksum(Checksum::calculate(buffer, sizeof(buffer))) == 0x220d);
+    return OK;
+}
+
+TestCase(ChecksumIPV4Header)
+{
+    u8 header[] = { 0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+                    0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+                    0xc0, 0xa8, 0x00, 0xc7 };
+
+    // Calculate checksum with the checksum field cleared
+    u16 checksum = Checksum::calculate(header, sizeof(header));
+    testAssert(storedChecksum(checksum) == 0xb861);
+
+    // Verifying a header including its checksum results in zero
+    header[10] = 0xb8;
+    header[11] = 0x61;
+    testAssert(Checksum::calculate(header, sizeof(header)) == 0);
+    return OK;
+}
+
+TestCase(ChecksumAlignment)
+{
+    TestInt<uint> bytes(0, 255);
+    u8 buffer[256 + 4];
+
+    for (Size i = 0; i < sizeof(buffer); i++)
+        buffer[i] = bytes.random();
+
+    // Compare against the reference for every offset and length
+    for (Size offset = 0; offset < 4; offset++)
+    {
+        for (Size length = 0; length <= 256; length++)
+        {
+            u16 checksum = Checksum::calculate(buffer + offset, length);
+            testAssert(storedChecksum(checksum) == referenceChecksum(buffer + offset, length));
+        }
+    }
+    return OK;
+}
+
+TestCase(ChecksumPartial)
+{
+    TestInt<uint> bytes(0, 255);
+    u8 buffer[128];
+
+    for (Size i = 0; i < sizeof(buffer); i++)
+        buffer[i] = bytes.random();
+
+    // Summing in even sized parts gives the same checksum
+    for (Size split = 0; split <= sizeof(buffer); split += 2)
+    {
+        u32 sum = Checksum::add(buffer, split);
+        sum = Checksum::add(buffer + split, sizeof(buffer) - split, sum);
+        testAssert(Checksum::finish(sum) == Checksum::calculate(buffer, sizeof(buffer)));
+    }
+    return OK;
+}
+
+TestCase(ChecksumUpdate16)
+{
+    u8 header[] = { 0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+                    0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+                    0xc0, 0xa8, 0x00, 0xc7 };
+    u16 *words = (u16 *) header;
+    u16 checksum = Checksum::calculate(header, sizeof(header));
+
+    // Decrement the TTL a number of times
+    for (Size i = 0; i < 0x40; i++)
+    {
+        u16 previous = words[4];
+        header[8]--;
+        checksum = Checksum::update(checksum, previous, words[4]);
+
+        testAssert(checksum == Checksum::calculate(header, sizeof(header)));
+    }
+    return OK;
+}
+
+TestCase(ChecksumUpdate32)
+{
+    u8 header[] = { 0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+                    0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+                    0xc0, 0xa8, 0x00, 0xc7 };
+    u32 *words = (u32 *) header;
+    u16 checksum = Checksum::calculate(header, sizeof(header));
+    TestInt<uint> addresses(0, UINT_MAX);
+
+    // Replace the destination address
+    for (Size i = 0; i < 64; i++)
+    {
+        u32 previous = words[4];
+        words[4] = addresses.random();
+        checksum = Checksum::update(checksum, previous, words[4]);
+
+        testAssert(checksum == Checksum::calculate(header, sizeof(header)));
+    }
+    return OK;
+}
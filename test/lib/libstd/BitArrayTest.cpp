@@ -282,6 +282,35 @@ TestCase(BitArraySetNextOutOfMemory)
     return OK;
 }
 
+TestCase(BitArraySetNextBoundary)
+{
+    BitArray ba(300);
+    Size bit;
+
+    // Occupy bits across word boundaries
+    ba.setRange(0, 40);
+    ba.set(60);
+    ba.set(64);
+
+    // The first free run of 16 bits on a 16-bit boundary starts at 80
+    testAssert(ba.setNext(&bit, 16, 0, 16) == BitArray::Success);
+    testAssert(bit == 80);
+
+    // Runs may cross words and end at the last bit
+    testAssert(ba.setNext(&bit, 44, 256) == BitArray::Success);
+    testAssert(bit == 256);
+    testAssert(ba.isSet(299));
+
+    // Unsetting a bit below the hint makes it available again
+    ba.unset(3);
+    testAssert(ba.setNext(&bit) == BitArray::Success);
+    testAssert(bit == 3);
+
+    // Check administration
+    testAssert(ba.count(true) == 41 + 2 + 16 + 44);
+    return OK;
+}
+
 TestCase(BitArrayClear)
 {
     TestInt<Size> indexes(0, 127);
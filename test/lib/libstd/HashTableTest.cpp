@@ -152,7 +152,8 @@ TestCase(HashTableAppend)
     }
     // Check administration
     testAssert(h.count() == size);
-    testAssert(h.size() == HASHTABLE_DEFAULT_SIZE);
+    testAssert(h.size() >= HASHTABLE_DEFAULT_SIZE);
+    testAssert(h.count() <= HASHTABLE_LOAD_FACTOR(h.size()));
     return OK;
 }
 
@@ -193,7 +194,8 @@ TestCase(HashTableRemove)
 
     // Check administration
     testAssert(h.count() == size - 1);
-    testAssert(h.size() == HASHTABLE_DEFAULT_SIZE);
+    testAssert(h.size() >= HASHTABLE_DEFAULT_SIZE);
+    testAssert(h.count() <= HASHTABLE_LOAD_FACTOR(h.size()));
     testAssert(!h.keys().contains(strings.get(0)));
     testAssert(h.get(strings.get(0)) == ZERO);
     return OK;
@@ -240,7 +242,8 @@ TestCase(HashTableRemoveMultiple)
 
     // Check administration
     testAssert(h.count() == size - 1);
-    testAssert(h.size() == HASHTABLE_DEFAULT_SIZE);
+    testAssert(h.size() >= HASHTABLE_DEFAULT_SIZE);
+    testAssert(h.count() <= HASHTABLE_LOAD_FACTOR(h.size()));
     testAssert(!h.keys().contains(strings.get(0)));
     testAssert(h.get(strings.get(0)) == ZERO);
     return OK;
@@ -293,3 +296,46 @@ TestCase(HashTableIterate)
     }
     return OK;
 }
+
+TestCase(HashTableResize)
+{
+    HashTable<int, int> h;
+    Size size = 1000;
+
+    // Insert enough keys to grow the table several times
+    for (Size i = 0; i < size; i++)
+        testAssert(h.insert(i, i * 2));
+
+    // Check administration
+    testAssert(h.count() == size);
+    testAssert(h.size() > HASHTABLE_DEFAULT_SIZE);
+    testAssert(h.count() <= HASHTABLE_LOAD_FACTOR(h.size()));
+    testAssert(h.keys().count() == size);
+
+    // Check all key/value pairs survived resizing
+    for (Size i = 0; i < size; i++)
+    {
+        testAssert(h.contains(i));
+        testAssert(h.value(i) == (int) i * 2);
+    }
+
+    // Remove all even keys
+    for (Size i = 0; i < size; i += 2)
+        testAssert(h.remove(i) == 1);
+
+    // Check the odd keys are still found
+    for (Size i = 0; i < size; i++)
+    {
+        if (i % 2)
+        {
+            testAssert(h.get(i) != ZERO);
+            testAssert(*h.get(i) == (int) i * 2);
+        }
+        else
+        {
+            testAssert(h.get(i) == ZERO);
+        }
+    }
+    testAssert(h.count() == size / 2);
+    return OK;
+}
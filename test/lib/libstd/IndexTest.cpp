@@ -31,3 +31,76 @@ TestCase(IndexOfStrings)
 {
     return SKIP;
 }
+
+TestCase(IndexInsert)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Index<int> index(8);
+
+    // Items are stored at the lowest positions first
+    ints.random(16);
+
+    for (Size i = 0; i < 16; i++)
+        testAssert(index.insert(ints[i]) == (int) i);
+
+    // The Index grows when full
+    testAssert(index.count() == 16);
+    testAssert(index.size() >= 16);
+
+    for (Size i = 0; i < 16; i++)
+        testAssert(index.get(i) == &ints[i]);
+
+    return OK;
+}
+
+TestCase(IndexRemove)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Index<int> index(8);
+
+    ints.random(8);
+
+    for (Size i = 0; i < 8; i++)
+        testAssert(index.insert(ints[i]) == (int) i);
+
+    // Removed positions are reused first
+    testAssert(index.remove((Size) 3));
+    testAssert(!index.remove((Size) 3));
+    testAssert(index.get(3) == ZERO);
+    testAssert(index.count() == 7);
+    testAssert(index.insert(ints[0]) == 3);
+    testAssert(index.size() == 8);
+
+    // Positional insert takes the position out of the free slots
+    testAssert(index.remove((Size) 5));
+    testAssert(index.remove((Size) 6));
+    testAssert(index.insert(5, ints[1]));
+    testAssert(index.insert(ints[2]) == 6);
+    testAssert(index.count() == 8);
+    return OK;
+}
+
+TestCase(IndexResize)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Index<int> index(4);
+
+    ints.random(2);
+
+    // Positional insert beyond the size grows the Index
+    testAssert(index.insert(10, ints[0]));
+    testAssert(index.size() >= 11);
+    testAssert(index.get(10) == &ints[0]);
+    testAssert(index.count() == 1);
+
+    // Cannot shrink below a stored item
+    testAssert(!index.resize(8));
+    testAssert(index.squeeze() == 11);
+    testAssert(index.remove((Size) 10));
+    testAssert(index.squeeze() == 1);
+    testAssert(index.insert(ints[1]) == 0);
+    testAssert(index.get(0) == &ints[1]);
+    testAssert(index.size() == 1);
+    return OK;
+}
+
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <MemoryBlock.h>
+
+/** Size of each benchmark buffer. */
+#define BENCH_SIZE (1024 * 1024 * 4)
+
+/** Number of iterations per benchmark. */
+#define BENCH_ITERATIONS 32
+
+/**
+ * Reference byte-at-a-time fill.
+ */
+static void byteSet(void *dest, int ch, Size count)
+{
+    volatile u8 *dst = (volatile u8 *) dest;
+
+    for (; count != 0; count--)
+        *dst++ = ch;
+}
+
+/**
+ * Reference byte-at-a-time copy.
+ */
+static void byteCopy(void *dest, const void *src, Size count)
+{
+    volatile u8 *dst = (volatile u8 *) dest;
+    const u8 *sp = (const u8 *) src;
+
+    for (; count != 0; count--)
+        *dst++ = *sp++;
+}
+
+/**
+ * Get the current time in microseconds.
+ */
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (tv.tv_sec * 1000000.0) + tv.tv_usec;
+}
+
+/**
+ * Print the throughput of a benchmark.
+ */
+static void report(const char *name, Size offset, double usec)
+{
+    double mbytes = ((double) BENCH_SIZE * BENCH_ITERATIONS) / (1024.0 * 1024.0);
+
+    printf("%-16s offset %u: %10.1f MiB/s\n", name, (uint) offset,
+           mbytes / (usec / 1000000.0));
+}
+
+int main(int argc, char **argv)
+{
+    u8 *src = new u8[BENCH_SIZE + 16];
+    u8 *dst = new u8[BENCH_SIZE + 16];
+    double t;
+
+    MemoryBlock::set(src, 0x5a, BENCH_SIZE + 16);
+    MemoryBlock::set(dst, 0, BENCH_SIZE + 16);
+
+    // Aligned and misaligned destination
+    for (Size offset = 0; offset < 2; offset++)
+    {
+        t = now();
+        for (Size i = 0; i < BENCH_ITERATIONS; i++)
+            byteSet(dst + offset, i, BENCH_SIZE);
+        report("byte set", offset, now() - t);
+
+        t = now();
+        for (Size i = 0; i < BENCH_ITERATIONS; i++)
+            MemoryBlock::set(dst + offset, i, BENCH_SIZE);
+        report("MemoryBlock::set", offset, now() - t);
+
+        t = now();
+        for (Size i = 0; i < BENCH_ITERATIONS; i++)
+            byteCopy(dst + offset, src, BENCH_SIZE);
+        report("byte copy", offset, now() - t);
+
+        t = now();
+        for (Size i = 0; i < BENCH_ITERATIONS; i++)
+            MemoryBlock::copy(dst + offset, src, BENCH_SIZE);
+        report("MemoryBlock::copy", offset, now() - t);
+    }
+
+    delete[] src;
+    delete[] dst;
+    return EXIT_SUCCESS;
+}
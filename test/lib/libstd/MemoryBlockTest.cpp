@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+
+/** Number of bytes in the test buffers. */
+#define BUFFER_SIZE 512
+
+/** Guard bytes around the tested region. */
+#define GUARD 0xee
+
+TestCase(MemoryBlockSet)
+{
+    u8 buf[BUFFER_SIZE];
+
+    // Try all destination alignments with small and large sizes
+    for (Size offset = 0; offset < 16; offset++)
+    {
+        for (Size count = 0; count < BUFFER_SIZE - 32; count += (count < 64 ? 1 : 37))
+        {
+            for (Size i = 0; i < BUFFER_SIZE; i++)
+                buf[i] = GUARD;
+
+            testAssert(MemoryBlock::set(buf + offset, 0x5a, count) == buf + offset);
+
+            for (Size i = 0; i < BUFFER_SIZE; i++)
+            {
+                if (i >= offset && i < offset + count)
+                {
+                    testAssert(buf[i] == 0x5a);
+                }
+                else
+                {
+                    testAssert(buf[i] == GUARD);
+                }
+            }
+        }
+    }
+    return OK;
+}
+
+TestCase(MemoryBlockCopy)
+{
+    TestInt<uint> bytes(0, 255);
+    u8 src[BUFFER_SIZE], dst[BUFFER_SIZE];
+
+    for (Size i = 0; i < BUFFER_SIZE; i++)
+        src[i] = bytes.random();
+
+    // Try all combinations of source and destination alignment
+    for (Size srcOffset = 0; srcOffset < 8; srcOffset++)
+    {
+        for (Size dstOffset = 0; dstOffset < 8; dstOffset++)
+        {
+            for (Size count = 0; count < BUFFER_SIZE - 16; count += (count < 64 ? 1 : 41))
+            {
+                for (Size i = 0; i < BUFFER_SIZE; i++)
+                    dst[i] = GUARD;
+
+                testAssert(MemoryBlock::copy(dst + dstOffset, src + srcOffset, count) == count);
+
+                for (Size i = 0; i < BUFFER_SIZE; i++)
+                {
+                    if (i >= dstOffset && i < dstOffset + count)
+                    {
+                        testAssert(dst[i] == src[i - dstOffset + srcOffset]);
+                    }
+                    else
+                    {
+                        testAssert(dst[i] == GUARD);
+                    }
+                }
+            }
+        }
+    }
+    return OK;
+}
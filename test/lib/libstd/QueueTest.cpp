@@ -69,6 +69,29 @@ TestCase(QueuePushPopInt)
     return OK;
 }
 
+TestCase(QueuePeek)
+{
+    Queue<int, 64> q;
+    TestInt<int> ints(INT_MIN, INT_MAX);
+
+    // Append two numbers
+    q.push(ints.random());
+    q.push(ints.random());
+
+    // Peek returns the oldest number without removing it
+    testAssert(q.peek() == ints[0]);
+    testAssert(q.count() == 2);
+    testAssert(q.pop() == ints[0]);
+
+    // Then the next number
+    testAssert(q.peek() == ints[1]);
+    testAssert(q.count() == 1);
+    testAssert(q.pop() == ints[1]);
+    testAssert(q.count() == 0);
+
+    return OK;
+}
+
 TestCase(QueueCycle)
 {
     Queue<int, 64> q;
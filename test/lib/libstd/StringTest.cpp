@@ -41,7 +41,7 @@ TestCase(StringConstructAlloc)
     // The String should be allocated
     testString(s.m_string, "Test data");
     testAssert(s.m_allocated);
-    testAssert(s.m_size == 10);
+    testAssert(s.m_size == STRING_DEFAULT_SIZE);
     testAssert(s.m_count == 9);
     testAssert(s.m_base == Number::Dec);
     return OK;
@@ -69,7 +69,8 @@ TestCase(StringConstructRandom)
     testString(s.m_string, strings.get(0));
     testAssert(s.m_allocated);
     testAssert(s.m_count == String::length(strings.get(0)));
-    testAssert(s.m_size == s.m_count + 1);
+    testAssert(s.m_size == (s.m_count < STRING_DEFAULT_SIZE ?
+                            STRING_DEFAULT_SIZE : s.m_count + 1));
     testAssert(s.m_base == Number::Dec);
     return OK;
 }
@@ -83,7 +84,7 @@ TestCase(StringConstructCopy)
     testString(s2.m_string, s1.m_string);
     testString(s2.m_string, "Hello");
     testAssert(s2.m_allocated);
-    testAssert(s2.m_size == 6);
+    testAssert(s2.m_size == STRING_DEFAULT_SIZE);
     testAssert(s2.m_count == 5);
     testAssert(s2.m_base == Number::Dec);
     return OK;
@@ -111,7 +112,8 @@ TestCase(StringLength)
     testAssert(s.length() == strings.length(0));
     testAssert(String::length(strings[0]) == strings.length(0));
     testAssert(s.m_count == strings.length(0));
-    testAssert(s.m_size == s.m_count + 1);
+    testAssert(s.m_size == (s.m_count < STRING_DEFAULT_SIZE ?
+                            STRING_DEFAULT_SIZE : s.m_count + 1));
     return OK;
 }
 
@@ -150,7 +152,7 @@ TestCase(StringResizeChop)
     // Check the resized String
     testString(s.m_string, "1234");
     testAssert(s.m_count == 4);
-    testAssert(s.m_size == 5);
+    testAssert(s.m_size == STRING_DEFAULT_SIZE);
     testAssert(s.m_allocated);
     testAssert(s.m_base == Number::Dec);
     return OK;
@@ -337,13 +339,13 @@ TestCase(StringSub)
     // Index only
     testString(s1.m_string, "sting1234");
     testAssert(s1.m_count == 9);
-    testAssert(s1.m_size == 10);
+    testAssert(s1.m_size == STRING_DEFAULT_SIZE);
 
     // Index with size
     String s2 = s.substring(3, 4);
     testString(s2.m_string, "ting");
     testAssert(s2.m_count == 4);
-    testAssert(s2.m_size == 9);
+    testAssert(s2.m_size == STRING_DEFAULT_SIZE);
 
     // Too large index
     String s3 = s.substring(100);
@@ -355,7 +357,7 @@ TestCase(StringSub)
     String s4 = s.substring(3, 100);
     testString(s4.m_string, "ting1234");
     testAssert(s4.m_count == 8);
-    testAssert(s4.m_size == 9);
+    testAssert(s4.m_size == STRING_DEFAULT_SIZE);
     return OK;
 }
 
@@ -368,7 +370,7 @@ TestCase(StringPad)
 
     testString(s.m_string, "hello\nthis      ");
     testAssert(s.m_count == 16);
-    testAssert(s.m_size == 17);
+    testAssert(s.m_size == STRING_DEFAULT_SIZE);
     return OK;
 }
 
@@ -394,7 +396,7 @@ TestCase(StringUpper)
 
     testString(s.m_string, "TESTING1234");
     testAssert(s.m_count == 11);
-    testAssert(s.m_size == 12);
+    testAssert(s.m_size == STRING_DEFAULT_SIZE);
     return OK;
 }
 
@@ -407,7 +409,7 @@ TestCase(StringLower)
 
     testString(s.m_string, "testing1234");
     testAssert(s.m_count == 11);
-    testAssert(s.m_size == 12);
+    testAssert(s.m_size == STRING_DEFAULT_SIZE);
     return OK;
 }
 
@@ -570,3 +572,49 @@ TestCase(StringShiftNumberBase)
     testString(s.m_string, "123 = 0x7b");
     return OK;
 }
+
+TestCase(StringInline)
+{
+    TestChar<char *> strings(STRING_DEFAULT_SIZE, STRING_DEFAULT_SIZE * 2);
+    String s1("short", true);
+    String s2(strings.random(), true);
+    String s3(s1), s4(s2);
+
+    // Short values are kept in the inline buffer
+    testAssert(s1.m_string == s1.m_inline);
+    testAssert(s3.m_string == s3.m_inline);
+    testString(s3.m_string, "short");
+
+    // Long values are allocated
+    testAssert(s2.m_string != s2.m_inline);
+    testAssert(s4.m_string != s4.m_inline);
+    testString(s4.m_string, strings.get(0));
+
+    // Shrinking moves the value back to the inline buffer
+    testAssert(s4.resize(10));
+    testAssert(s4.m_string == s4.m_inline);
+    testAssert(s4.m_count == 9);
+    testAssert(s4.m_allocated);
+    return OK;
+}
+
+TestCase(StringHash)
+{
+    String s1("testing1234", true);
+    String s2 = "testing1234";
+
+    // Equal values have equal hashes
+    testAssert(s1.hash() == s2.hash());
+    testAssert(s1.m_hash == s1.hash());
+
+    // Modifying the String resets the cached hash
+    s1 << "5";
+    testAssert(s1.m_hash == ZERO);
+    testAssert(s1.hash() != s2.hash());
+
+    // Copies keep the cached hash
+    String s3(s2);
+    testAssert(s3.m_hash == s2.m_hash);
+    testAssert(s3.hash() == s2.hash());
+    return OK;
+}
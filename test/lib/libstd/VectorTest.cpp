@@ -280,3 +280,33 @@ TestCase(VectorCompare)
     testAssert(a1.count() != a2.count());
     return OK;
 }
+
+TestCase(VectorSqueeze)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Vector<int> a(8);
+
+    // Reserve grows at least by a factor of two
+    testAssert(a.reserve(9));
+    testAssert(a.size() == 16);
+    testAssert(a.reserve(100));
+    testAssert(a.size() == 100);
+
+    // Insert a few items
+    for (Size i = 0; i < 10; i++)
+        testAssert(a.insert(ints.random()) == (int) i);
+
+    // Squeeze must keep all items
+    testAssert(a.squeeze() == 10);
+    testAssert(a.size() == 10);
+    testAssert(a.count() == 10);
+
+    for (Size i = 0; i < 10; i++)
+        testAssert(a[i] == ints[i]);
+
+    // Shrinking below the count drops items
+    testAssert(a.resize(5));
+    testAssert(a.count() == 5);
+    testAssert(a.get(5) == ZERO);
+    return OK;
+}